@@ -0,0 +1,130 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include "testdecl/weekday.hpp"
+#include <mirror/serialize/parallel_read.hpp>
+#include <mirror/serialize/record_stream.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <sstream>
+#include <string>
+#include <thread>
+//------------------------------------------------------------------------------
+// benchmarked records
+//------------------------------------------------------------------------------
+namespace bench {
+
+struct employee {
+    std::string name;
+    int id{0};
+    double salary{0.0};
+    example::weekday day_off{example::weekday::sunday};
+};
+
+} // namespace bench
+//------------------------------------------------------------------------------
+// timing harness
+//------------------------------------------------------------------------------
+void measure(
+  const char* framing_name,
+  mirror::serialize::record_framing framing,
+  mirror::serialize::record_order order,
+  std::span<const std::byte> input,
+  std::size_t record_count,
+  unsigned thread_count) {
+    using namespace mirror::serialize;
+    std::atomic<std::size_t> consumed{0U};
+    const auto run = [&]() {
+        consumed = 0U;
+        return !parallel_read_records<bench::employee>(
+                 input,
+                 framing,
+                 [&](bench::employee&) { ++consumed; },
+                 order,
+                 thread_count) &&
+               consumed == record_count;
+    };
+    // the first run is a warm-up which also validates the reading
+    if(!run()) {
+        std::cerr << framing_name << '/' << thread_count << ": failed"
+                  << std::endl;
+        return;
+    }
+
+    const double min_time_ns{5.E8};
+    std::size_t repeats{1U};
+    double elapsed_ns{0.0};
+    while(true) {
+        const auto start{std::chrono::steady_clock::now()};
+        for(std::size_t r = 0U; r < repeats; ++r) {
+            run();
+        }
+        elapsed_ns = std::chrono::duration<double, std::nano>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+        if(elapsed_ns >= min_time_ns) {
+            break;
+        }
+        repeats *= 2U;
+    }
+
+    const double ns_per_op{elapsed_ns / double(repeats)};
+    std::cout << std::left << std::setw(10) << framing_name << std::setw(11)
+              << (order == record_order::preserved ? "preserved" : "arbitrary")
+              << std::right << std::setw(8) << thread_count << std::fixed
+              << std::setprecision(2) << std::setw(12) << ns_per_op * 1.E-6
+              << std::setprecision(1) << std::setw(12)
+              << double(input.size()) * 1.E3 / ns_per_op << std::setw(14)
+              << double(record_count) * 1.E6 / ns_per_op << std::endl;
+}
+//------------------------------------------------------------------------------
+void benchmark(
+  const char* framing_name,
+  mirror::serialize::record_framing framing,
+  std::size_t record_count) {
+    using namespace mirror::serialize;
+    std::ostringstream out;
+    record_stream_writer<bench::employee> writer{out, framing};
+    for(std::size_t i = 0U; i < record_count; ++i) {
+        writer.write(
+          {"employee " + std::to_string(i),
+           int(i),
+           1000.0 + double(i),
+           example::weekday(1 + int(i % 7U))});
+    }
+    const std::string data{std::move(out).str()};
+    const auto input{std::as_bytes(std::span(data))};
+
+    const unsigned max_threads{
+      std::max(std::thread::hardware_concurrency(), 1U)};
+    for(const auto order : {record_order::preserved, record_order::arbitrary}) {
+        for(unsigned t = 1U; t < max_threads; t *= 2U) {
+            measure(framing_name, framing, order, input, record_count, t);
+        }
+        measure(framing_name, framing, order, input, record_count, max_threads);
+    }
+}
+//------------------------------------------------------------------------------
+int main() {
+    using namespace mirror::serialize;
+    const std::size_t record_count{200000U};
+
+    std::cout << std::left << std::setw(10) << "framing" << std::setw(11)
+              << "order" << std::right << std::setw(8) << "threads"
+              << std::setw(12) << "ms/op" << std::setw(12) << "MB/s"
+              << std::setw(14) << "records/ms" << std::endl;
+
+    benchmark("json", record_framing::json_lines, record_count);
+    benchmark("binary", record_framing::binary_frames, record_count);
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include "testdecl/cards.hpp"
+#include "testdecl/month.hpp"
+#include "testdecl/tetrahedron.hpp"
+#include "testdecl/weekday.hpp"
+#include <mirror/registry.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+//------------------------------------------------------------------------------
+// registration of the benchmarked metadata
+//------------------------------------------------------------------------------
+static void register_all(mirror::metadata_registry& r) {
+    r.add(mirror(example::cards::rank));
+    r.add(mirror(example::cards::suit));
+    r.add(mirror(example::cards::card));
+    r.add(mirror(example::cards::deck));
+    r.add(mirror(example::cards::player));
+    r.add(mirror(example::cards::dealer));
+    r.add(mirror(example::month));
+    r.add(mirror(example::weekday));
+    r.add(mirror(example::point));
+    r.add(mirror(example::vector));
+    r.add(mirror(example::triangle));
+    r.add(mirror(example::tetrahedron));
+}
+
+// the lookups done by the first use of a type, like in serialization
+static auto lookup_all(mirror::metadata_registry& r) -> std::size_t {
+    std::size_t result{0U};
+    result += get_metadata(mirror(example::cards::card), r).count();
+    result += get_metadata(mirror(example::cards::deck), r).count();
+    result += get_metadata(mirror(example::weekday), r).count();
+    result += get_metadata(mirror(example::point), r).count();
+    result += get_metadata(mirror(example::tetrahedron), r).count();
+    result += r.find(mirror(example::month)).count();
+    result += r.find(mirror(example::triangle)).count();
+    result += r.find(mirror(example::cards::dealer)).count();
+    return result;
+}
+
+constexpr const std::size_t lookups_per_call{8U};
+//------------------------------------------------------------------------------
+// runs func concurrently on the specified number of threads
+//------------------------------------------------------------------------------
+template <typename F>
+auto run_threads(unsigned thread_count, F func) -> double {
+    std::atomic<unsigned> ready{0U};
+    std::atomic<bool> go{false};
+    std::vector<std::jthread> threads;
+    threads.reserve(thread_count);
+    for(unsigned t = 0U; t < thread_count; ++t) {
+        threads.emplace_back([&]() {
+            ++ready;
+            while(!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            func();
+        });
+    }
+    while(ready.load() < thread_count) {
+        std::this_thread::yield();
+    }
+    const auto start{std::chrono::steady_clock::now()};
+    go.store(true, std::memory_order_release);
+    threads.clear();
+    return std::chrono::duration<double, std::nano>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+//------------------------------------------------------------------------------
+int main() {
+    const std::size_t calls_per_thread{200000U};
+
+    std::cout << std::left << std::setw(10) << "threads" << std::right
+              << std::setw(16) << "lookups/s" << std::setw(14)
+              << "ns/lookup" << std::setw(16) << "register [us]"
+              << std::endl;
+
+    for(unsigned thread_count : {1U, 2U, 4U, 8U, 16U, 32U, 64U}) {
+        // concurrent lookups of registered metadata
+        mirror::metadata_registry registered;
+        register_all(registered);
+        std::atomic<std::size_t> checksum{0U};
+        const double lookup_ns{run_threads(thread_count, [&]() {
+            std::size_t sum{0U};
+            for(std::size_t c = 0U; c < calls_per_thread; ++c) {
+                sum += lookup_all(registered);
+            }
+            checksum += sum;
+        })};
+        const double lookups{
+          double(thread_count) * double(calls_per_thread * lookups_per_call)};
+
+        // all the threads lazily register the same metadata at once
+        mirror::metadata_registry contended;
+        const double register_ns{
+          run_threads(thread_count, [&]() { register_all(contended); })};
+
+        if(checksum.load() == 0U || contended.size() != registered.size()) {
+            std::cerr << thread_count << " threads: inconsistent results"
+                      << std::endl;
+            return 1;
+        }
+
+        std::cout << std::left << std::setw(10) << thread_count << std::right
+                  << std::fixed << std::setprecision(0) << std::setw(16)
+                  << lookups * 1.E9 / lookup_ns << std::setprecision(2)
+                  << std::setw(14) << lookup_ns / lookups * double(thread_count)
+                  << std::setw(16) << register_ns / 1.E3 << std::endl;
+    }
+
+    return 0;
+}
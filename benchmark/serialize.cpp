@@ -0,0 +1,210 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include "testdecl/cards.hpp"
+#include "testdecl/tetrahedron.hpp"
+#include "testdecl/weekday.hpp"
+#include <mirror/serialize/read_binary.hpp>
+#include <mirror/serialize/read_rapidjson.hpp>
+#include <mirror/serialize/write_binary.hpp>
+#include <mirror/serialize/write_rapidjson.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <optional>
+#include <string>
+#include <vector>
+//------------------------------------------------------------------------------
+// allocation counting
+//------------------------------------------------------------------------------
+static std::size_t allocation_count{0U};
+
+auto operator new(std::size_t size) -> void* {
+    ++allocation_count;
+    if(void* ptr{std::malloc(size > 0U ? size : 1U)}) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+//------------------------------------------------------------------------------
+// benchmarked shapes
+//------------------------------------------------------------------------------
+namespace bench {
+
+struct flat {
+    bool b{false};
+    int i{0};
+    long long l{0};
+    float f{0.F};
+    double d{0.0};
+    std::string s;
+};
+
+struct employee {
+    std::string name;
+    int id{0};
+    double salary{0.0};
+    example::weekday day_off{example::weekday::sunday};
+};
+
+struct enum_heavy {
+    example::cards::rank high{example::cards::rank::ace};
+    example::cards::rank low{example::cards::rank::two};
+    example::cards::suit suit{example::cards::suit::hearts};
+    example::cards::suit trump{example::cards::suit::spades};
+    example::weekday first{example::weekday::monday};
+    example::weekday last{example::weekday::sunday};
+};
+
+struct optionals {
+    std::optional<int> count;
+    std::optional<double> ratio;
+    std::optional<std::string> label;
+    std::optional<example::weekday> day;
+    std::optional<flat> extra;
+};
+
+} // namespace bench
+//------------------------------------------------------------------------------
+// timing harness
+//------------------------------------------------------------------------------
+template <typename F>
+void measure(
+  const char* shape,
+  const char* backend,
+  const char* operation,
+  std::size_t bytes,
+  F func) {
+    // the first run is a warm-up which also validates the round-trip
+    if(!func()) {
+        std::cerr << shape << '/' << backend << '/' << operation
+                  << ": failed" << std::endl;
+        return;
+    }
+
+    const double min_time_ns{2.E8};
+    std::size_t repeats{1U};
+    std::size_t allocations{0U};
+    double elapsed_ns{0.0};
+    while(true) {
+        const auto alloc_start{allocation_count};
+        const auto start{std::chrono::steady_clock::now()};
+        for(std::size_t r = 0U; r < repeats; ++r) {
+            func();
+        }
+        elapsed_ns = std::chrono::duration<double, std::nano>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+        allocations = allocation_count - alloc_start;
+        if(elapsed_ns >= min_time_ns) {
+            break;
+        }
+        repeats *= 2U;
+    }
+
+    const double ns_per_op{elapsed_ns / double(repeats)};
+    std::cout << std::left << std::setw(14) << shape << std::setw(13)
+              << backend << std::setw(7) << operation << std::right
+              << std::fixed << std::setprecision(1) << std::setw(14)
+              << ns_per_op << std::setw(12)
+              << double(bytes) * 1.E3 / ns_per_op << std::setw(12)
+              << std::setprecision(2)
+              << double(allocations) / double(repeats) << std::endl;
+}
+//------------------------------------------------------------------------------
+template <typename T>
+void benchmark(const char* shape, const T& original) {
+    using namespace mirror::serialize;
+    // reading goes into a populated object, like in a message loop
+    T copy{original};
+
+    std::vector<std::byte> buffer;
+    write_binary(original, buffer);
+    measure(shape, "binary", "write", buffer.size(), [&]() {
+        buffer.clear();
+        return !write_binary(original, buffer);
+    });
+    measure(shape, "binary", "read", buffer.size(), [&]() {
+        return !read_binary(copy, std::span<const std::byte>(buffer));
+    });
+
+    std::string json;
+    write_rapidjson_string(original, json);
+    measure(shape, "json-sax", "write", json.size(), [&]() {
+        return !write_rapidjson_string(original, json);
+    });
+    std::string insitu;
+    measure(shape, "json-insitu", "read", json.size(), [&]() {
+        insitu = json;
+        return !read_rapidjson_insitu(copy, insitu);
+    });
+
+    measure(shape, "json-dom", "write", json.size(), [&]() {
+        rapidjson::Document doc;
+        return !write_rapidjson(original, doc);
+    });
+    measure(shape, "json-dom", "read", json.size(), [&]() {
+        rapidjson::Document doc;
+        doc.Parse(json.data(), json.size());
+        return !doc.HasParseError() && !read_rapidjson(copy, doc);
+    });
+}
+//------------------------------------------------------------------------------
+int main() {
+    const bench::flat flat{true, 123456, -1234567890123LL, 1.5F, 2.25, "flat"};
+
+    const example::tetrahedron tetrahedron{
+      {{1.F, 0.F, 0.F}, {0.F, 1.F, 0.F}, {0.F, 0.F, 1.F}}, {0.F}};
+
+    std::vector<bench::employee> employees;
+    employees.reserve(10000U);
+    for(std::size_t i = 0U; i < 10000U; ++i) {
+        employees.push_back(
+          {"employee " + std::to_string(i),
+           int(i),
+           1000.0 + double(i),
+           example::weekday(1 + int(i % 7U))});
+    }
+
+    std::vector<bench::enum_heavy> hands;
+    for(std::size_t i = 0U; i < 100U; ++i) {
+        hands.push_back(
+          {example::cards::rank(1 + int(i % 13U)),
+           example::cards::rank(1 + int((i + 5U) % 13U)),
+           example::cards::suit(int(i % 4U)),
+           example::cards::suit(int((i + 1U) % 4U)),
+           example::weekday(1 + int(i % 7U)),
+           example::weekday(1 + int((i + 3U) % 7U))});
+    }
+
+    const bench::optionals optionals{
+      42, 0.5, "label", example::weekday::friday, flat};
+
+    std::cout << std::left << std::setw(14) << "shape" << std::setw(13)
+              << "backend" << std::setw(7) << "op" << std::right
+              << std::setw(14) << "ns/op" << std::setw(12) << "MB/s"
+              << std::setw(12) << "allocs/op" << std::endl;
+
+    benchmark("flat", flat);
+    benchmark("tetrahedron", tetrahedron);
+    benchmark("records", employees);
+    benchmark("enums", hands);
+    benchmark("optionals", optionals);
+    benchmark("no-optionals", bench::optionals{});
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+/// @example mirror/binary_vs_rapidjson.cpp
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include "testdecl/tetrahedron.hpp"
+#include <mirror/serialize/read_binary.hpp>
+#include <mirror/serialize/read_rapidjson.hpp>
+#include <mirror/serialize/write_binary.hpp>
+#include <mirror/serialize/write_rapidjson.hpp>
+#include <chrono>
+#include <iostream>
+
+template <typename F>
+void measure(
+  const char* label,
+  std::size_t repeats,
+  std::size_t bytes,
+  F func) {
+    const auto start{std::chrono::steady_clock::now()};
+    for(std::size_t i = 0; i < repeats; ++i) {
+        if(!func()) {
+            std::cerr << label << ": round-trip failed" << std::endl;
+            return;
+        }
+    }
+    const std::chrono::duration<double, std::nano> elapsed{
+      std::chrono::steady_clock::now() - start};
+    std::cout << label << ": " << elapsed.count() / double(repeats)
+              << " ns/round-trip, " << bytes << " bytes" << std::endl;
+}
+
+int main() {
+    const std::size_t repeats{100000};
+    const example::tetrahedron original{
+      {{1.F, 0.F, 0.F}, {0.F, 1.F, 0.F}, {0.F, 0.F, 1.F}}, {0.F}};
+    example::tetrahedron copy{};
+
+    std::vector<std::byte> buffer;
+    mirror::serialize::write_binary(original, buffer);
+    measure("binary", repeats, buffer.size(), [&]() {
+        buffer.clear();
+        return !mirror::serialize::write_binary(original, buffer) &&
+               !mirror::serialize::read_binary(
+                 copy, std::span<const std::byte>(buffer));
+    });
+
+    std::string json;
+    mirror::serialize::write_rapidjson_string(original, json);
+    measure("rapidjson", repeats, json.size(), [&]() {
+        return !mirror::serialize::write_rapidjson_string(original, json) &&
+               !mirror::serialize::read_rapidjson_string(copy, json);
+    });
+
+    return 0;
+}
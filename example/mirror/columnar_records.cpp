@@ -0,0 +1,64 @@
+/// @example mirror/columnar_records.cpp
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <mirror/serialize/columnar.hpp>
+#include <mirror/serialize/read_binary.hpp>
+#include <mirror/serialize/read_rapidjson.hpp>
+#include <mirror/serialize/write_binary.hpp>
+#include <mirror/serialize/write_rapidjson.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct sample {
+    std::string sensor;
+    double value{0.0};
+    int quality{0};
+};
+
+int main() {
+    using namespace mirror::serialize;
+    const std::vector<sample> samples{
+      {"north", 12.5, 3}, {"south", 13.25, 2}, {"east", 11.75, 3}};
+
+    // the member names are written once, the values of each member together
+    std::string json;
+    if(write_rapidjson_string(as_columns(samples), json)) {
+        std::cerr << "failed to write JSON columns" << std::endl;
+        return 1;
+    }
+    std::cout << json << std::endl;
+
+    std::vector<sample> from_json;
+    // the wrapper is read through a named object
+    auto json_columns{as_columns(from_json)};
+    if(read_rapidjson_string(json_columns, json)) {
+        std::cerr << "failed to read JSON columns" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::byte> buffer;
+    if(write_binary(as_columns(samples), buffer)) {
+        std::cerr << "failed to write binary columns" << std::endl;
+        return 1;
+    }
+    std::vector<sample> from_binary;
+    auto binary_columns{as_columns(from_binary)};
+    if(read_binary(binary_columns, std::span<const std::byte>(buffer))) {
+        std::cerr << "failed to read binary columns" << std::endl;
+        return 1;
+    }
+
+    for(const auto& s : from_binary) {
+        std::cout << s.sensor << ": " << s.value << " (" << s.quality << ")"
+                  << std::endl;
+    }
+    std::cout << "records read from JSON: " << from_json.size()
+              << ", binary size: " << buffer.size() << " bytes" << std::endl;
+
+    return 0;
+}
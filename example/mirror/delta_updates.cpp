@@ -0,0 +1,61 @@
+/// @example mirror/delta_updates.cpp
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <mirror/serialize/delta.hpp>
+#include <mirror/serialize/read_binary.hpp>
+#include <mirror/serialize/write_binary.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct position {
+    double x{0.0};
+    double y{0.0};
+};
+
+struct player {
+    std::string name;
+    position pos;
+    int score{0};
+    std::vector<std::string> items;
+};
+
+void print(const player& p) {
+    std::cout << p.name << " at (" << p.pos.x << ", " << p.pos.y
+              << "), score " << p.score << ", " << p.items.size() << " items"
+              << std::endl;
+}
+
+int main() {
+    using namespace mirror::serialize;
+    const player before{"hero", {1.0, 2.0}, 10, {"sword"}};
+    player after{before};
+    after.pos.y = 3.5;
+    after.score = 25;
+
+    // only the changed members are written, the position member-wise
+    std::vector<std::byte> buffer;
+    buffer_data_sink<> sink{buffer};
+    basic_binary_write_backend<buffer_data_sink<>> write_backend;
+    if(write_delta(before, after, write_backend, {sink})) {
+        std::cerr << "failed to write the delta" << std::endl;
+        return 1;
+    }
+    std::cout << "delta size: " << buffer.size() << " bytes" << std::endl;
+
+    // the replica has the old state and receives only the delta
+    player replica{before};
+    span_data_source source{buffer};
+    basic_binary_read_backend<span_data_source> read_backend;
+    if(apply_delta(replica, read_backend, {source})) {
+        std::cerr << "failed to apply the delta" << std::endl;
+        return 1;
+    }
+    print(replica);
+
+    return 0;
+}
@@ -0,0 +1,44 @@
+/// @example mirror/record_streams.cpp
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include "testdecl/weekday.hpp"
+#include <mirror/serialize/record_stream.hpp>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+struct shift {
+    std::string employee;
+    example::weekday day{example::weekday::monday};
+    int hours{0};
+};
+
+void copy_records(mirror::serialize::record_framing framing) {
+    using namespace mirror::serialize;
+    std::stringstream stream;
+    record_stream_writer<shift> writer{stream, framing};
+    for(int i = 0; i < 5; ++i) {
+        writer.write(
+          {"employee " + std::to_string(i), example::weekday(1 + i), 6 + i});
+    }
+
+    // the records are read one at a time into a reused value
+    record_stream_reader<shift> reader{stream, framing};
+    int total_hours{0};
+    for(const shift& s : reader) {
+        total_hours += s.hours;
+    }
+    std::cout << reader.count() << " records, " << total_hours << " hours"
+              << (reader.errors() ? ", with errors" : "") << std::endl;
+}
+
+int main() {
+    using namespace mirror::serialize;
+    copy_records(record_framing::json_lines);
+    copy_records(record_framing::binary_frames);
+    return 0;
+}
@@ -0,0 +1,36 @@
+/// @example mirror/static_puml_class_diagram.cpp
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#include "testdecl/cards.hpp"
+#include <mirror/puml.hpp>
+#include <mirror/static_registry.hpp>
+#include <iostream>
+
+namespace example::cards {
+// built during compilation, there is no registration at startup
+static constexpr const mirror::static_metadata_registry registry{
+  mirror(example::cards),
+  mirror(rank),
+  mirror(suit),
+  mirror(card),
+  mirror(deck),
+  mirror(player),
+  mirror(dealer)};
+} // namespace example::cards
+
+int main() {
+    const auto& r = example::cards::registry;
+    const auto& md_cards = r.find(mirror(example::cards));
+
+    mirror::puml_class_diagram puml;
+    puml.generate(std::cout, r.filtered([&](const auto& md) {
+        return md.scope() == md_cards;
+    }));
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+/// @example mirror/versioned_records.cpp
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+#include <mirror/serialize/read_binary.hpp>
+#include <mirror/serialize/versioned.hpp>
+#include <mirror/serialize/write_binary.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace v1 {
+struct person {
+    std::string name;
+    int age{0};
+};
+} // namespace v1
+
+namespace v2 {
+struct person {
+    std::string name;
+    std::string email{"unknown"};
+    int age{0};
+    bool active{true};
+};
+} // namespace v2
+
+void print(const v1::person& p) {
+    std::cout << "v1: " << p.name << ", " << p.age << std::endl;
+}
+
+void print(const v2::person& p) {
+    std::cout << "v2: " << p.name << ", " << p.email << ", " << p.age << ", "
+              << std::boolalpha << p.active << std::endl;
+}
+
+int main() {
+    using namespace mirror::serialize;
+    std::vector<std::byte> buffer;
+
+    // an old writer and a new reader, the added members keep their defaults
+    const v1::person old_person{"Alice", 42};
+    if(write_binary(as_versioned(old_person), buffer)) {
+        std::cerr << "failed to write v1" << std::endl;
+        return 1;
+    }
+    v2::person new_person{};
+    // the wrapper is read through a named object
+    auto new_wrapped{as_versioned(new_person)};
+    if(read_binary(new_wrapped, std::span<const std::byte>(buffer))) {
+        std::cerr << "failed to read v2" << std::endl;
+        return 1;
+    }
+    print(new_person);
+
+    // a new writer and an old reader, the unknown attributes are skipped
+    buffer.clear();
+    const v2::person newer_person{"Bob", "bob@example.com", 37, false};
+    if(write_binary(as_versioned(newer_person), buffer)) {
+        std::cerr << "failed to write v2" << std::endl;
+        return 1;
+    }
+    v1::person older_person{};
+    auto old_wrapped{as_versioned(older_person)};
+    if(read_binary(old_wrapped, std::span<const std::byte>(buffer))) {
+        std::cerr << "failed to read v1" << std::endl;
+        return 1;
+    }
+    print(older_person);
+
+    return 0;
+}
@@ -17,6 +17,8 @@
 #include "placeholder.hpp"
 #include "sequence.hpp"
 #include "traits.hpp"
+#include "value_compare.hpp"
+#include "value_hash.hpp"
 
 #endif // MIRROR_ALL_HPP
 
@@ -9,44 +9,215 @@
 #ifndef MIRROR_ENUM_UTILS_HPP
 #define MIRROR_ENUM_UTILS_HPP
 
+#include "name_index.hpp"
 #include "primitives.hpp"
+#include "sequence.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <optional>
+#include <type_traits>
 
 namespace mirror {
 
+template <typename E, __metaobject_id... M>
+consteval auto _enum_values(unpacked_metaobject_sequence<M...>) noexcept
+  -> std::array<E, sizeof...(M)> {
+    return {{get_constant(wrapped_metaobject<M>{})...}};
+}
+
+template <__metaobject_id... M>
+consteval auto _enum_names(unpacked_metaobject_sequence<M...>) noexcept
+  -> std::array<string_view, sizeof...(M)> {
+    return {{get_name(wrapped_metaobject<M>{})...}};
+}
+
+// maps enum values to unsigned integers, preserving the distances
+template <typename E>
+constexpr auto _enum_key(E e) noexcept -> std::uintmax_t {
+    using U = std::underlying_type_t<E>;
+    if constexpr(std::is_signed_v<U>) {
+        return std::uintmax_t(std::intmax_t(U(e)));
+    } else {
+        return std::uintmax_t(U(e));
+    }
+}
+
+template <typename E, std::size_t N>
+consteval auto _enum_min(const std::array<E, N>& values) noexcept -> E {
+    using U = std::underlying_type_t<E>;
+    E result{};
+    for(std::size_t i = 0; i < N; ++i) {
+        if(i == 0 || U(values[i]) < U(result)) {
+            result = values[i];
+        }
+    }
+    return result;
+}
+
+template <typename E, std::size_t N>
+consteval auto _enum_span(const std::array<E, N>& values, E min) noexcept
+  -> std::uintmax_t {
+    std::uintmax_t result{0U};
+    for(const E value : values) {
+        result = std::max(result, _enum_key(value) - _enum_key(min));
+    }
+    return result;
+}
+
+// positions (plus one) of the enumerators indexed by their offset from min,
+// the last of the enumerators sharing a value is kept
+template <std::size_t S, typename E, std::size_t N>
+consteval auto _enum_dense(const std::array<E, N>& values, E min) noexcept
+  -> std::array<std::uint32_t, S> {
+    std::array<std::uint32_t, S> result{};
+    for(std::size_t i = 0; i < N; ++i) {
+        result[std::size_t(_enum_key(values[i]) - _enum_key(min))] =
+          std::uint32_t(i + 1U);
+    }
+    return result;
+}
+
+// positions of the enumerators ordered by their values, the enumerators
+// sharing a value are in reverse order, so that the last one is found first
+template <std::size_t S, typename E, std::size_t N>
+consteval auto _enum_sorted(const std::array<E, N>& values) noexcept
+  -> std::array<std::uint32_t, S> {
+    using U = std::underlying_type_t<E>;
+    std::array<std::uint32_t, S> result{};
+    for(std::size_t i = 0; i < S; ++i) {
+        result[i] = std::uint32_t(i);
+    }
+    std::sort(
+      result.begin(), result.end(), [&](std::uint32_t l, std::uint32_t r) {
+          return U(values[l]) < U(values[r]) ||
+                 (U(values[l]) == U(values[r]) && l > r);
+      });
+    return result;
+}
+
+/// @brief Compile-time generated tables for looking up enumerators of type E.
+/// @ingroup utilities
+/// @see enum_to_string
+/// @see string_to_enum
+///
+/// Values are looked up in a dense array indexed by the offset from the
+/// smallest enumerator if the enumerators are (nearly) contiguous, otherwise
+/// by binary search in a table sorted by value. Names are looked up with
+/// a name_index. If several enumerators share a value, the last one wins.
+template <typename E>
+class enum_lookup {
+    using _mes_t = decltype(unpack(get_enumerators(mirror(E))));
+
+    static constexpr const std::size_t _count{get_size(_mes_t{})};
+    static constexpr const std::array<E, _count> _values{
+      _enum_values<E>(_mes_t{})};
+    static constexpr const std::array<string_view, _count> _names{
+      _enum_names(_mes_t{})};
+    static constexpr const E _min{_enum_min(_values)};
+    static constexpr const bool _is_dense{
+      _enum_span(_values, _min) < 2U * _count + 8U};
+    static constexpr const std::size_t _dense_size{
+      _is_dense && _count > 0U ? std::size_t(_enum_span(_values, _min)) + 1U
+                               : 0U};
+    static constexpr const std::array<std::uint32_t, _dense_size> _dense{
+      _enum_dense<_dense_size>(_values, _min)};
+    static constexpr const std::array<std::uint32_t, _is_dense ? 0U : _count>
+      _sorted{_enum_sorted<_is_dense ? 0U : _count>(_values)};
+    static constexpr const name_index<_count> _index{_names};
+
+public:
+    /// @brief Returns the number of enumerators of E.
+    static constexpr auto size() noexcept -> std::size_t {
+        return _count;
+    }
+
+    /// @brief Returns the position of the enumerator with the specified value.
+    static constexpr auto find(E value) noexcept -> std::optional<std::size_t> {
+        if constexpr(_is_dense) {
+            const auto offset{_enum_key(value) - _enum_key(_min)};
+            if(offset < _dense_size) {
+                if(const auto pos{_dense[std::size_t(offset)]}) {
+                    return {pos - 1U};
+                }
+            }
+        } else {
+            using U = std::underlying_type_t<E>;
+            const auto pos{std::lower_bound(
+              _sorted.begin(), _sorted.end(), value, [](std::uint32_t i, E v) {
+                  return U(_values[i]) < U(v);
+              })};
+            if(pos != _sorted.end() && _values[*pos] == value) {
+                return {*pos};
+            }
+        }
+        return {};
+    }
+
+    /// @brief Returns the position of the enumerator with the specified name.
+    static constexpr auto find(string_view name) noexcept
+      -> std::optional<std::size_t> {
+        return _index.find(name);
+    }
+
+    /// @brief Returns the name of the enumerator at the specified position.
+    static constexpr auto name(std::size_t pos) noexcept -> string_view {
+        return _names[pos];
+    }
+
+    /// @brief Returns the value of the enumerator at the specified position.
+    static constexpr auto value(std::size_t pos) noexcept -> E {
+        return _values[pos];
+    }
+
+    /// @brief Returns the bitwise-or of the values of all enumerators.
+    static constexpr auto value_mask() noexcept
+      -> std::make_unsigned_t<std::underlying_type_t<E>> {
+        using M = std::make_unsigned_t<std::underlying_type_t<E>>;
+        M result{0U};
+        for(const E value : _values) {
+            result = M(result | M(value));
+        }
+        return result;
+    }
+
+    /// @brief Returns the name of the enumerator with the specified value.
+    /// Returns an empty string view if there is no such enumerator.
+    static constexpr auto name_of(E value) noexcept -> string_view {
+        if(const auto pos{find(value)}) {
+            return _names[*pos];
+        }
+        return {};
+    }
+
+    /// @brief Returns the value of the enumerator with the specified name.
+    static constexpr auto value_of(string_view name) noexcept
+      -> std::optional<E> {
+        if(const auto pos{_index.find(name)}) {
+            return {_values[*pos]};
+        }
+        return {};
+    }
+};
+
 /// @brief Returns the name of the specified enumerator.
 /// @ingroup utilities
 /// @see string_to_enum
+/// @see enum_lookup
 template <typename E>
 auto enum_to_string(E e) noexcept -> string_view {
-    return select(
-      get_enumerators(mirror(E)),
-      [](auto& result, auto mo, auto c) {
-          if(get_constant(mo) == c) {
-              result = get_name(mo);
-          }
-      },
-      string_view{},
-      e);
+    return enum_lookup<E>::name_of(e);
 }
 
 /// @brief Finds the value of enum type @c E with the specified name.
 /// @ingroup utilities
 /// @see enum_to_string
+/// @see enum_lookup
 template <typename E>
 auto string_to_enum(string_view s) noexcept -> std::optional<E> {
-    return select(
-      get_enumerators(mirror(E)),
-      [](auto& result, auto mo, auto n) {
-          if(get_name(mo) == n) {
-              result = get_constant(mo);
-          }
-      },
-      std::optional<E>{},
-      s);
+    return enum_lookup<E>::value_of(s);
 }
 
 } // namespace mirror
 
 #endif // MIRROR_ENUM_UTILS_HPP
-
@@ -15,10 +15,10 @@
 namespace mirror {
 
 template <__metaobject_id M>
-auto get_full_name(wrapped_metaobject<M>) -> std::string;
+constexpr auto get_full_name(wrapped_metaobject<M>) -> std::string;
 
 template <__metaobject_id Mp>
-auto get_qualified_name(wrapped_metaobject<Mp> mo) -> std::string
+constexpr auto get_qualified_name(wrapped_metaobject<Mp> mo) -> std::string
   requires(__metaobject_is_meta_named(Mp)) {
     if constexpr(reflects_global_scope_member(mo) || !reflects_scope_member(mo)) {
         return std::string{get_name(mo)};
@@ -35,127 +35,137 @@ auto get_qualified_name(wrapped_metaobject<Mp> mo) -> std::string
 
 namespace _full_type_name {
 
+// std::to_string is not usable in constant expressions
+constexpr auto to_string(std::size_t n) -> std::string {
+    std::string s;
+    do {
+        s.insert(s.begin(), char('0' + n % 10U));
+        n /= 10U;
+    } while(n);
+    return s;
+}
+
 struct defaults {
-    static auto left(std::string s = {}) {
+    static constexpr auto left(std::string s = {}) {
         return s;
     }
 
-    static auto base(std::string s = {}) {
+    static constexpr auto base(std::string s = {}) {
         return s;
     }
 
-    static auto right(std::string s = {}) {
+    static constexpr auto right(std::string s = {}) {
         return s;
     }
 
-    static auto extents(std::string s = {}) {
+    static constexpr auto extents(std::string s = {}) {
         return s;
     }
 
-    static auto params(std::string s = {}) {
+    static constexpr auto params(std::string s = {}) {
         return s;
     }
 };
 
 template <typename T>
 struct decorate : defaults {
-    static auto base(std::string = {}) {
+    static constexpr auto base(std::string = {}) {
         return get_qualified_name(remove_all_aliases(mirror(T)));
     }
 };
 
 template <typename T>
 struct decorate_defaults {
-    static auto left(std::string s = {}) {
+    static constexpr auto left(std::string s = {}) {
         return decorate<T>::left(std::move(s));
     }
-    static auto base(std::string s = {}) {
+    static constexpr auto base(std::string s = {}) {
         return decorate<T>::base(std::move(s));
     }
-    static auto right(std::string s = {}) {
+    static constexpr auto right(std::string s = {}) {
         return decorate<T>::right(std::move(s));
     }
-    static auto extents(std::string s = {}) {
+    static constexpr auto extents(std::string s = {}) {
         return decorate<T>::extents(std::move(s));
     }
-    static auto params(std::string s = {}) {
+    static constexpr auto params(std::string s = {}) {
         return decorate<T>::params(std::move(s));
     }
 };
 
 template <typename T>
 struct decorate<T*> : decorate_defaults<T> {
-    static auto right(std::string s = {}) {
+    static constexpr auto right(std::string s = {}) {
         return decorate<T>::right(s) + "*";
     }
 };
 
 template <typename T>
 struct decorate<T&> : decorate_defaults<T> {
-    static auto right(std::string s = {}) {
+    static constexpr auto right(std::string s = {}) {
         return decorate<T>::right(s) + "&";
     }
 };
 
 template <typename T>
 struct decorate<T&&> : decorate_defaults<T> {
-    static auto right(std::string s = {}) {
+    static constexpr auto right(std::string s = {}) {
         return decorate<T>::right(s) + "&&";
     }
 };
 
 template <typename T>
 struct decorate<T const> : decorate_defaults<T> {
-    static auto right(std::string s = {}) {
+    static constexpr auto right(std::string s = {}) {
         return decorate<T>::right(s) + " const";
     }
 };
 
 template <typename T>
 struct decorate<T volatile> : decorate_defaults<T> {
-    static auto right(std::string s = {}) {
+    static constexpr auto right(std::string s = {}) {
         return decorate<T>::right(s) + " volatile";
     }
 };
 
 template <typename T>
 struct decorate<T const volatile> : decorate_defaults<T> {
-    static auto right(std::string s = {}) {
+    static constexpr auto right(std::string s = {}) {
         return decorate<T>::right(s) + " const volatile";
     }
 };
 
 template <typename T>
 struct decorate<T[]> : decorate_defaults<T> {
-    static auto extents(std::string s = {}) {
+    static constexpr auto extents(std::string s = {}) {
         return decorate<T>::extents(s + "[]");
     }
 };
 
 template <typename T, std::size_t N>
 struct decorate<T[N]> : decorate_defaults<T> {
-    static auto extents(std::string s = {}) {
-        return decorate<T>::extents(s + "[" + std::to_string(N) + "]");
+    static constexpr auto extents(std::string s = {}) {
+        return decorate<T>::extents(s + "[" + to_string(N) + "]");
     }
 };
 
-static inline auto make_list(type_list<>) -> std::string {
+static constexpr auto make_list(type_list<>) -> std::string {
     return {};
 }
 
 template <typename P1, typename... P>
-auto make_list(type_list<P1, P...>) -> std::string {
+constexpr auto make_list(type_list<P1, P...>) -> std::string {
     return (
       get_full_name(mirror(P1)) + ... + (", " + get_full_name(mirror(P))));
 }
 
 template <typename R, typename... P>
 struct decorate<R(P...)> : defaults {
-    static auto left(std::string s = {}) {
+    static constexpr auto left(std::string s = {}) {
         using DR = decorate<R>;
         return s + DR::left() + DR::base() + DR::right() + DR::extents();
     }
-    static auto params(std::string s = {}) {
+    static constexpr auto params(std::string s = {}) {
         using DR = decorate<R>;
         return s + "(" + make_list(type_list<P...>{}) + ")" + DR::params();
     }
@@ -163,11 +173,11 @@ struct decorate<R(P...)> : defaults {
 
 template <typename R, typename... P>
 struct decorate<R(P...) noexcept> : defaults {
-    static auto left(std::string s = {}) {
+    static constexpr auto left(std::string s = {}) {
         using DR = decorate<R>;
         return s + DR::left() + DR::base() + DR::right() + DR::extents();
     }
-    static auto params(std::string s = {}) {
+    static constexpr auto params(std::string s = {}) {
         using DR = decorate<R>;
         return s + "(" + make_list(type_list<P...>{}) + ") noexcept" +
                DR::params();
@@ -176,14 +186,14 @@ struct decorate<R(P...) noexcept> : defaults {
 
 template <typename R, typename... P>
 struct decorate<R (*)(P...)> : defaults {
-    static auto left(std::string s = {}) {
+    static constexpr auto left(std::string s = {}) {
         using DR = decorate<R>;
         return s + DR::left() + DR::base() + DR::right() + DR::extents() + "(";
     }
-    static auto right(std::string s = {}) {
+    static constexpr auto right(std::string s = {}) {
         return "*" + s;
     }
-    static auto params(std::string s = {}) {
+    static constexpr auto params(std::string s = {}) {
         using DR = decorate<R>;
         return ")" + s + "(" + make_list(type_list<P...>{}) + ")" +
                DR::params();
@@ -192,14 +202,14 @@ struct decorate<R (*)(P...)> : defaults {
 
 template <typename R, typename... P>
 struct decorate<R (*)(P...) noexcept> : defaults {
-    static auto left(std::string s = {}) {
+    static constexpr auto left(std::string s = {}) {
         using DR = decorate<R>;
         return s + DR::left() + DR::base() + DR::right() + DR::extents() + "(";
     }
-    static auto right(std::string s = {}) {
+    static constexpr auto right(std::string s = {}) {
         return "*" + s;
     }
-    static auto params(std::string s = {}) {
+    static constexpr auto params(std::string s = {}) {
         using DR = decorate<R>;
         return ")" + s + "(" + make_list(type_list<P...>{}) + ") noexcept" +
                DR::params();
@@ -208,17 +218,17 @@ struct decorate<R (*)(P...) noexcept> : defaults {
 
 template <typename R, typename C, typename... P>
 struct decorate<R (C::*)(P...)> : defaults {
-    static auto left(std::string s = {}) {
+    static constexpr auto left(std::string s = {}) {
         using DR = decorate<R>;
         return s + DR::left() + DR::base() + DR::right() + DR::extents() + "(";
     }
-    static auto base(std::string s = {}) {
+    static constexpr auto base(std::string s = {}) {
         return get_full_name(mirror(C)) + "::" + s;
     }
-    static auto right(std::string s = {}) {
+    static constexpr auto right(std::string s = {}) {
         return "*" + s;
     }
-    static auto params(std::string s = {}) {
+    static constexpr auto params(std::string s = {}) {
         using DR = decorate<R>;
         return ")" + s + "(" + make_list(type_list<P...>{}) + ")" +
                DR::params();
@@ -227,7 +237,7 @@ struct decorate<R (C::*)(P...)> : defaults {
 
 template <typename R, typename C, typename... P>
 struct decorate<R (C::*)(P...)&> : decorate<R (C::*)(P...)> {
-    static auto params(std::string s = {}) {
+    static constexpr auto params(std::string s = {}) {
         using DR = decorate<R>;
         return ")" + s + "(" + make_list(type_list<P...>{}) + ") &" +
                DR::params();
@@ -236,7 +246,7 @@ struct decorate<R (C::*)(P...)&> : decorate<R (C::*)(P...)> {
 
 template <typename R, typename C, typename... P>
 struct decorate<R (C::*)(P...) &&> : decorate<R (C::*)(P...)> {
-    static auto params(std::string s = {}) {
+    static constexpr auto params(std::string s = {}) {
         using DR = decorate<R>;
         return ")" + s + "(" + make_list(type_list<P...>{}) + ") &&" +
                DR::params();
@@ -245,7 +255,7 @@ struct decorate<R (C::*)(P...) &&> : decorate<R (C::*)(P...)> {
 
 template <typename R, typename C, typename... P>
 struct decorate<R (C::*)(P...) const> : decorate<R (C::*)(P...)> {
-    static auto params(std::string s = {}) {
+    static constexpr auto params(std::string s = {}) {
         using DR = decorate<R>;
         return ")" + s + "(" + make_list(type_list<P...>{}) + ") const" +
                DR::params();
@@ -254,7 +264,7 @@ struct decorate<R (C::*)(P...) const> : decorate<R (C::*)(P...)> {
 
 template <typename R, typename C, typename... P>
 struct decorate<R (C::*)(P...) noexcept> : decorate<R (C::*)(P...)> {
-    static auto params(std::string s = {}) {
+    static constexpr auto params(std::string s = {}) {
         using DR = decorate<R>;
         return ")" + s + "(" + make_list(type_list<P...>{}) + ") noexcept" +
                DR::params();
@@ -263,7 +273,7 @@ struct decorate<R (C::*)(P...) noexcept> : decorate<R (C::*)(P...)> {
 
 template <typename R, typename C, typename... P>
 struct decorate<R (C::*)(P...)& noexcept> : decorate<R (C::*)(P...)> {
-    static auto params(std::string s = {}) {
+    static constexpr auto params(std::string s = {}) {
         using DR = decorate<R>;
         return ")" + s + "(" + make_list(type_list<P...>{}) + ") & noexcept" +
                DR::params();
@@ -272,7 +282,7 @@ struct decorate<R (C::*)(P...)& noexcept> : decorate<R (C::*)(P...)> {
 
 template <typename R, typename C, typename... P>
 struct decorate<R (C::*)(P...)&& noexcept> : decorate<R (C::*)(P...)> {
-    static auto params(std::string s = {}) {
+    static constexpr auto params(std::string s = {}) {
         using DR = decorate<R>;
         return ")" + s + "(" + make_list(type_list<P...>{}) + ") && noexcept" +
                DR::params();
@@ -281,7 +291,7 @@ struct decorate<R (C::*)(P...)&& noexcept> : decorate<R (C::*)(P...)> {
 
 template <typename R, typename C, typename... P>
 struct decorate<R (C::*)(P...) const noexcept> : decorate<R (C::*)(P...)> {
-    static auto params(std::string s = {}) {
+    static constexpr auto params(std::string s = {}) {
         using DR = decorate<R>;
         return ")" + s + "(" + make_list(type_list<P...>{}) +
                ") const noexcept" + DR::params();
@@ -290,25 +300,25 @@ struct decorate<R (C::*)(P...) const noexcept> : decorate<R (C::*)(P...)> {
 
 template <typename T, typename C>
 struct decorate<T C::*> : defaults {
-    static auto left(std::string s = {}) {
+    static constexpr auto left(std::string s = {}) {
         using DT = decorate<T>;
         return s + DT::left() + DT::base() + DT::right() + DT::extents();
     }
-    static auto base(std::string s = {}) {
+    static constexpr auto base(std::string s = {}) {
         return " " + get_full_name(mirror(C)) + "::" + s;
     }
-    static auto right(std::string s = {}) {
+    static constexpr auto right(std::string s = {}) {
         return "*" + s;
     }
 };
 
 template <template <typename...> class T, typename... P>
 struct decorate<T<P...>> : defaults {
-    static auto base(std::string = {}) {
+    static constexpr auto base(std::string = {}) {
         return get_qualified_name(remove_all_aliases(mirror(T<P...>)));
     }
 
-    static auto right(std::string s = {}) {
+    static constexpr auto right(std::string s = {}) {
         return "<" + make_list(type_list<P...>{}) + ">" + s;
     }
 };
@@ -323,7 +333,7 @@ struct decorate<T<P...>> : defaults {
 /// @see get_display_name
 /// @see has_name
 template <__metaobject_id Mp>
-auto get_full_name(wrapped_metaobject<Mp> mo) -> std::string {
+constexpr auto get_full_name(wrapped_metaobject<Mp> mo) -> std::string {
     if constexpr(reflects_type(mo)) {
         using D = _full_type_name::decorate<__unrefltype(Mp)>;
         return D::left() + D::base() + D::right() + D::extents() + D::params();
@@ -12,14 +12,23 @@
 #include "full_name.hpp"
 #include "placeholder.hpp"
 #include "sequence.hpp"
-#include <functional>
+#include <cstdint>
+#include <string_view>
 
 namespace mirror {
 
-// TODO: make the hashes platform-independent
-
 using hash_t = std::uint64_t;
 
+// FNV-1a, usable in constant expressions and the same on all platforms
+constexpr auto _hash_name(std::string_view name) noexcept -> hash_t {
+    hash_t h{0xcbf29ce484222325ULL};
+    for(const char c : name) {
+        h ^= std::uint8_t(c);
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
 template <__metaobject_id M>
 constexpr auto get_hash(wrapped_metaobject<M>) -> hash_t
   requires(__metaobject_is_meta_global_scope(M)) {
@@ -32,7 +41,7 @@ constexpr auto get_hash(wrapped_metaobject<M> mo) -> hash_t requires(
   !__metaobject_is_meta_global_scope(M) && !__metaobject_is_meta_callable(M) &&
   !__metaobject_is_meta_function_call_expression(M) &&
   !__metaobject_is_meta_parenthesized_expression(M)) {
-    return std::hash<std::string>{}(get_full_name(mo));
+    return _hash_name(get_full_name(mo));
 }
 
 constexpr auto _do_get_hash(unpacked_metaobject_sequence<>, hash_t s)
@@ -43,8 +52,7 @@ constexpr auto _do_get_hash(unpacked_metaobject_sequence<>, hash_t s)
 template <__metaobject_id M, __metaobject_id... Ms>
 constexpr auto _do_get_hash(unpacked_metaobject_sequence<M, Ms...>, hash_t s)
   -> hash_t {
-    return s ^
-           std::hash<std::string>{}(get_full_name(wrapped_metaobject<M>{})) ^
+    return s ^ _hash_name(get_full_name(wrapped_metaobject<M>{})) ^
            _do_get_hash(unpacked_metaobject_sequence<Ms...>{}, s + 1);
 }
 
@@ -62,7 +70,7 @@ constexpr auto get_hash(wrapped_metaobject<M> mo) -> hash_t
 template <__metaobject_id M>
 constexpr auto get_hash(wrapped_metaobject<M> mo) -> hash_t
   requires(__metaobject_is_meta_callable(M)) {
-    return std::hash<std::string>{}(get_full_name(mo)) ^
+    return _hash_name(get_full_name(mo)) ^
            get_hash(transform(get_parameters(mo), get_type(_1)));
 }
 
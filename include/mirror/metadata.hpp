@@ -13,8 +13,12 @@
 #include "operations.hpp"
 #include "registry_fwd.hpp"
 #include "traits.hpp"
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <iterator>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <vector>
 
@@ -28,17 +32,17 @@ public:
 //------------------------------------------------------------------------------
 class metadata_iterator {
 private:
-    using base_iter_t = std::vector<const metadata*>::const_iterator;
+    using base_iter_t = const metadata* const*;
     base_iter_t _iter{};
 
 public:
     using value_type = const metadata;
     using pointer = const metadata*;
     using reference = const metadata&;
-    using difference_type = base_iter_t::difference_type;
-    using iterator_category = base_iter_t::iterator_category;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::random_access_iterator_tag;
 
-    metadata_iterator(base_iter_t iter) noexcept
+    constexpr metadata_iterator(base_iter_t iter) noexcept
       : _iter{iter} {}
 
     friend auto
@@ -117,14 +121,24 @@ public:
 class metadata_sequence {
 private:
     std::vector<const metadata*> _elements;
+    // set instead of _elements in metadata built at compile time
+    std::span<const metadata* const> _static_elements{};
+
+    constexpr auto _view() const noexcept -> std::span<const metadata* const> {
+        if(_static_elements.empty()) {
+            return {_elements};
+        }
+        return _static_elements;
+    }
 
 protected:
-    metadata_sequence() noexcept = default;
+    constexpr metadata_sequence() noexcept = default;
 
     metadata_sequence(std::vector<const metadata*> elements) noexcept
       : _elements{elements} {}
 
     friend class metadata_registry;
+    friend class metadata_selection;
 
     auto _emplace_elements(std::vector<const metadata*> elements) noexcept
       -> auto& {
@@ -132,30 +146,43 @@ protected:
         return _elements;
     }
 
+    constexpr void _set_static_elements(
+      std::span<const metadata* const> elements) noexcept {
+        _static_elements = elements;
+    }
+
 public:
+    /// @brief Constructs a sequence viewing a static array of metadata.
+    constexpr explicit metadata_sequence(
+      std::span<const metadata* const> elements) noexcept
+      : _static_elements{elements} {}
+
     friend auto operator+(const metadata_sequence& l, const metadata_sequence& r)
       -> metadata_sequence {
+        const auto lv{l._view()};
+        const auto rv{r._view()};
         std::vector<const metadata*> elements;
-        elements.reserve(l._elements.size() + r._elements.size());
-        elements.insert(elements.end(), l._elements.begin(), l._elements.end());
-        elements.insert(elements.end(), r._elements.begin(), r._elements.end());
+        elements.reserve(lv.size() + rv.size());
+        elements.insert(elements.end(), lv.begin(), lv.end());
+        elements.insert(elements.end(), rv.begin(), rv.end());
         return {elements};
     }
 
-    auto element(size_t index) const noexcept -> const metadata& {
-        return *_elements[index];
+    constexpr auto element(size_t index) const noexcept -> const metadata& {
+        return *_view()[index];
     }
 
-    auto count() const noexcept -> size_t {
-        return _elements.size();
+    constexpr auto count() const noexcept -> size_t {
+        return _view().size();
     }
 
-    auto begin() const noexcept -> metadata_iterator {
-        return {_elements.begin()};
+    constexpr auto begin() const noexcept -> metadata_iterator {
+        return {_view().data()};
     }
 
-    auto end() const noexcept -> metadata_iterator {
-        return {_elements.end()};
+    constexpr auto end() const noexcept -> metadata_iterator {
+        const auto view{_view()};
+        return {view.data() + view.size()};
     }
 
     auto contains(const metadata& md) const noexcept;
@@ -210,6 +237,8 @@ private:
     std::string_view _name{};
     std::string_view _display_name{};
 
+    friend class metadata_columns;
+
 protected:
     const metadata& _none{*this};
     const metadata* _scope{&_none};
@@ -231,14 +260,33 @@ protected:
     const metadata* _operators{&_none};
     const metadata* _parameters{&_none};
 
-    auto _needs_elements() const noexcept -> bool {
+    // the links of registered metadata may be completed while other threads
+    // follow them, at run-time they are loaded and stored atomically
+    static constexpr auto _load_link(const metadata* const& link) noexcept
+      -> const metadata& {
+        if consteval {
+            return *link;
+        } else {
+            return *std::atomic_ref<const metadata*>{
+              const_cast<const metadata*&>(link)}
+                      .load(std::memory_order_acquire);
+        }
+    }
+
+    static void
+    _store_link(const metadata*& link, const metadata& md) noexcept {
+        std::atomic_ref<const metadata*>{link}.store(
+          &md, std::memory_order_release);
+    }
+
+    constexpr auto _needs_elements() const noexcept -> bool {
         return _op_boolean_applicable.has(trait::is_empty) &&
                !_op_boolean_results.has(trait::is_empty) && (count() == 0Z);
     }
 
-    metadata() noexcept = default;
+    constexpr metadata() noexcept = default;
 
-    metadata(
+    constexpr metadata(
       hash_t id,
       meta_traits meta_tr,
       type_traits type_tr,
@@ -271,9 +319,9 @@ public:
     auto operator=(metadata&&) = delete;
     metadata(const metadata&) = delete;
     auto operator=(const metadata&) = delete;
-    ~metadata() noexcept = default;
+    constexpr ~metadata() noexcept = default;
 
-    auto is_none() const noexcept {
+    constexpr auto is_none() const noexcept {
         return !_meta_traits.has(trait::reflects_object);
     }
 
@@ -293,7 +341,7 @@ public:
         return l._id < r._id;
     }
 
-    auto id() const noexcept -> hash_t {
+    constexpr auto id() const noexcept -> hash_t {
         return _id;
     }
 
@@ -395,7 +443,7 @@ public:
         return {};
     }
 
-    auto name_() const noexcept -> std::string_view {
+    constexpr auto name_() const noexcept -> std::string_view {
         return _name;
     }
 
@@ -406,72 +454,72 @@ public:
         return {};
     }
 
-    auto scope() const noexcept -> const metadata& {
-        return *_scope;
+    constexpr auto scope() const noexcept -> const metadata& {
+        return _load_link(_scope);
     }
 
-    auto type() const noexcept -> const metadata& {
-        return *_type;
+    constexpr auto type() const noexcept -> const metadata& {
+        return _load_link(_type);
     }
 
-    auto base_type() const noexcept -> const metadata& {
-        return *_base_type;
+    constexpr auto base_type() const noexcept -> const metadata& {
+        return _load_link(_base_type);
     }
 
-    auto element_type() const noexcept -> const metadata& {
-        return *_element_type;
+    constexpr auto element_type() const noexcept -> const metadata& {
+        return _load_link(_element_type);
     }
 
-    auto underlying_type() const noexcept -> const metadata& {
-        return *_underlying_type;
+    constexpr auto underlying_type() const noexcept -> const metadata& {
+        return _load_link(_underlying_type);
     }
 
-    auto aliased() const noexcept -> const metadata& {
-        return *_aliased;
+    constexpr auto aliased() const noexcept -> const metadata& {
+        return _load_link(_aliased);
     }
 
-    auto class_() const noexcept -> const metadata& {
-        return *_class;
+    constexpr auto class_() const noexcept -> const metadata& {
+        return _load_link(_class);
     }
 
-    auto base_classes() const noexcept -> const metadata& {
-        return *_base_classes;
+    constexpr auto base_classes() const noexcept -> const metadata& {
+        return _load_link(_base_classes);
     }
 
-    auto captures() const noexcept -> const metadata& {
-        return *_captures;
+    constexpr auto captures() const noexcept -> const metadata& {
+        return _load_link(_captures);
     }
 
-    auto constructors() const noexcept -> const metadata& {
-        return *_constructors;
+    constexpr auto constructors() const noexcept -> const metadata& {
+        return _load_link(_constructors);
     }
 
-    auto data_members() const noexcept -> const metadata& {
-        return *_data_members;
+    constexpr auto data_members() const noexcept -> const metadata& {
+        return _load_link(_data_members);
     }
 
-    auto destructors() const noexcept -> const metadata& {
-        return *_destructors;
+    constexpr auto destructors() const noexcept -> const metadata& {
+        return _load_link(_destructors);
     }
 
-    auto enumerators() const noexcept -> const metadata& {
-        return *_enumerators;
+    constexpr auto enumerators() const noexcept -> const metadata& {
+        return _load_link(_enumerators);
     }
 
-    auto member_functions() const noexcept -> const metadata& {
-        return *_member_functions;
+    constexpr auto member_functions() const noexcept -> const metadata& {
+        return _load_link(_member_functions);
     }
 
-    auto member_types() const noexcept -> const metadata& {
-        return *_member_types;
+    constexpr auto member_types() const noexcept -> const metadata& {
+        return _load_link(_member_types);
     }
 
-    auto operators() const noexcept -> const metadata& {
-        return *_operators;
+    constexpr auto operators() const noexcept -> const metadata& {
+        return _load_link(_operators);
     }
 
-    auto parameters() const noexcept -> const metadata& {
-        return *_parameters;
+    constexpr auto parameters() const noexcept -> const metadata& {
+        return _load_link(_parameters);
     }
 
     auto size() const noexcept -> std::optional<size_t> {
@@ -548,7 +596,7 @@ static inline auto extract(const metadata_value& v) noexcept
 }
 //------------------------------------------------------------------------------
 inline auto metadata_sequence::contains(const metadata& md) const noexcept {
-    for(const auto* pmd : _elements) {
+    for(const auto* pmd : _view()) {
         if(*pmd == md) {
             return true;
         }
@@ -560,7 +608,7 @@ template <typename F>
 inline auto metadata_sequence::filtered(F predicate) const
   -> metadata_sequence {
     std::vector<const metadata*> result;
-    for(const auto* md : _elements) {
+    for(const auto* md : _view()) {
         if(predicate(*md)) {
             result.push_back(md);
         }
@@ -0,0 +1,385 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef MIRROR_METADATA_QUERY_HPP
+#define MIRROR_METADATA_QUERY_HPP
+
+#include "metadata.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace mirror {
+//------------------------------------------------------------------------------
+/// @brief Lazy view of the metadata selected by a query on metadata_columns.
+/// @see metadata_columns
+///
+/// The selection is a dense bitmap with one bit per row of the columns.
+/// Selections from the same columns are combined with the bitwise operators
+/// without accessing the metadata, which is dereferenced only when the
+/// selection is iterated or converted to a metadata_sequence.
+class metadata_selection {
+private:
+    using _word_t = std::uint64_t;
+    static constexpr const size_t _word_bits{64Z};
+
+    const std::vector<const metadata*>* _rows{nullptr};
+    std::vector<_word_t> _words;
+
+    friend class metadata_columns;
+
+    metadata_selection(const std::vector<const metadata*>& rows)
+      : _rows{&rows}
+      , _words((rows.size() + _word_bits - 1Z) / _word_bits) {}
+
+    // clears the bits past the last row
+    void _trim() noexcept {
+        if(const size_t tail{_rows->size() % _word_bits}) {
+            _words.back() &= (_word_t{1U} << tail) - 1U;
+        }
+    }
+
+public:
+    class iterator {
+    private:
+        const metadata_selection* _parent{nullptr};
+        size_t _word{0Z};
+        _word_t _bits{0U};
+
+        void _skip_empty() noexcept {
+            while(!_bits && ++_word < _parent->_words.size()) {
+                _bits = _parent->_words[_word];
+            }
+        }
+
+    public:
+        using value_type = const metadata;
+        using pointer = const metadata*;
+        using reference = const metadata&;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+
+        iterator() noexcept = default;
+
+        iterator(const metadata_selection& parent, size_t word) noexcept
+          : _parent{&parent}
+          , _word{word} {
+            if(_word < _parent->_words.size()) {
+                _bits = _parent->_words[_word];
+                _skip_empty();
+            }
+        }
+
+        friend auto operator==(const iterator& l, const iterator& r) noexcept
+          -> bool {
+            return l._word == r._word && l._bits == r._bits;
+        }
+
+        friend auto operator!=(const iterator& l, const iterator& r) noexcept
+          -> bool {
+            return !(l == r);
+        }
+
+        auto operator++() noexcept -> auto& {
+            // clears the lowest set bit
+            _bits &= _bits - 1U;
+            _skip_empty();
+            return *this;
+        }
+
+        auto operator++(int) noexcept -> auto {
+            auto copy{*this};
+            ++*this;
+            return copy;
+        }
+
+        auto operator*() const noexcept -> const metadata& {
+            const auto bit{size_t(std::countr_zero(_bits))};
+            return *(*_parent->_rows)[_word * _word_bits + bit];
+        }
+    };
+
+    auto begin() const noexcept -> iterator {
+        return {*this, 0Z};
+    }
+
+    auto end() const noexcept -> iterator {
+        return {*this, _words.size()};
+    }
+
+    /// @brief Returns the number of the selected metadata.
+    auto count() const noexcept -> size_t {
+        size_t result{0Z};
+        for(const auto word : _words) {
+            result += size_t(std::popcount(word));
+        }
+        return result;
+    }
+
+    /// @brief Indicates if no metadata is selected.
+    auto is_empty() const noexcept -> bool {
+        return std::all_of(_words.begin(), _words.end(), [](_word_t word) {
+            return word == 0U;
+        });
+    }
+
+    /// @brief Copies the pointers to the selected metadata into a sequence.
+    auto to_sequence() const -> metadata_sequence {
+        std::vector<const metadata*> elements;
+        elements.reserve(count());
+        for(const auto& md : *this) {
+            elements.push_back(&md);
+        }
+        return {elements};
+    }
+
+    /// @brief Keeps only the metadata selected also by that selection.
+    auto operator&=(const metadata_selection& that) noexcept
+      -> metadata_selection& {
+        assert(_rows == that._rows && _words.size() == that._words.size());
+        for(size_t w = 0Z; w < _words.size(); ++w) {
+            _words[w] &= that._words[w];
+        }
+        return *this;
+    }
+
+    /// @brief Adds the metadata selected by that selection.
+    auto operator|=(const metadata_selection& that) noexcept
+      -> metadata_selection& {
+        assert(_rows == that._rows && _words.size() == that._words.size());
+        for(size_t w = 0Z; w < _words.size(); ++w) {
+            _words[w] |= that._words[w];
+        }
+        return *this;
+    }
+
+    /// @brief Selects the metadata selected by both selections.
+    friend auto operator&(metadata_selection l, const metadata_selection& r)
+      -> metadata_selection {
+        l &= r;
+        return l;
+    }
+
+    /// @brief Selects the metadata selected by either of the selections.
+    friend auto operator|(metadata_selection l, const metadata_selection& r)
+      -> metadata_selection {
+        l |= r;
+        return l;
+    }
+
+    /// @brief Selects the metadata not selected by the selection.
+    friend auto operator~(metadata_selection s) -> metadata_selection {
+        for(auto& word : s._words) {
+            word = ~word;
+        }
+        s._trim();
+        return s;
+    }
+};
+//------------------------------------------------------------------------------
+/// @brief Columnar copy of the traits of metadata for repeated queries.
+/// @see metadata_selection
+/// @see metadata_registry
+/// @see metadata_sequence
+///
+/// The trait and operation bitfields of a range of metadata, like those in
+/// a metadata_registry or a metadata_sequence, are copied into parallel
+/// arrays. The queries, named like the filters of metadata_sequence, scan
+/// only the arrays they need into a metadata_selection and do not allocate
+/// per element. Compound queries combine the selections.
+///
+/// The columns are a snapshot of the range. Calling update appends the rows
+/// of the metadata added to the range since, which makes the selections
+/// made before the update incompatible with the ones made after it.
+class metadata_columns {
+private:
+    using _word_t = metadata_selection::_word_t;
+    static constexpr const size_t _word_bits{metadata_selection::_word_bits};
+
+    std::vector<const metadata*> _rows;
+    std::vector<meta_traits::value_type> _meta_traits;
+    std::vector<type_traits::value_type> _type_traits;
+    std::vector<operations_boolean::value_type> _op_boolean_results;
+    std::vector<operations_boolean::value_type> _op_boolean_applicable;
+    std::vector<operations_metaobject::value_type> _op_metaobject_applicable;
+    std::vector<operations_integer::value_type> _op_integer_applicable;
+    std::vector<operations_string::value_type> _op_string_applicable;
+
+    void _append(const metadata& md) {
+        _rows.push_back(&md);
+        _meta_traits.push_back(md._meta_traits.bits());
+        _type_traits.push_back(md._type_traits.bits());
+        _op_boolean_results.push_back(md._op_boolean_results.bits());
+        _op_boolean_applicable.push_back(md._op_boolean_applicable.bits());
+        _op_metaobject_applicable.push_back(
+          md._op_metaobject_applicable.bits());
+        _op_integer_applicable.push_back(md._op_integer_applicable.bits());
+        _op_string_applicable.push_back(md._op_string_applicable.bits());
+    }
+
+    // the bits of each word are computed without branching, so that
+    // the inner loop can be vectorized
+    template <typename P>
+    auto _scan(P predicate) const -> metadata_selection {
+        metadata_selection result{_rows};
+        for(size_t w = 0Z; w < result._words.size(); ++w) {
+            const size_t begin{w * _word_bits};
+            const size_t end{std::min(begin + _word_bits, _rows.size())};
+            _word_t word{0U};
+            for(size_t i = begin; i < end; ++i) {
+                word |= _word_t(predicate(i)) << (i - begin);
+            }
+            result._words[w] = word;
+        }
+        return result;
+    }
+
+    template <typename T, typename B>
+    auto _scan_all(const std::vector<T>& column, B bits) const
+      -> metadata_selection {
+        const T mask{bits.bits()};
+        return _scan([&](size_t i) { return (column[i] & mask) == mask; });
+    }
+
+    template <typename T, typename B>
+    auto _scan_some(const std::vector<T>& column, B bits) const
+      -> metadata_selection {
+        const T mask{bits.bits()};
+        return _scan([&](size_t i) { return (column[i] & mask) != T{0}; });
+    }
+
+public:
+    metadata_columns() noexcept = default;
+
+    /// @brief Copies the traits of the metadata in the specified range.
+    template <typename Range>
+    explicit metadata_columns(const Range& range) {
+        update(range);
+    }
+
+    // the selections refer to the rows
+    metadata_columns(metadata_columns&&) = delete;
+    metadata_columns(const metadata_columns&) = delete;
+    auto operator=(metadata_columns&&) = delete;
+    auto operator=(const metadata_columns&) = delete;
+    ~metadata_columns() noexcept = default;
+
+    /// @brief Appends the metadata past the already copied part of the range.
+    template <typename Range>
+    void update(const Range& range) {
+        auto pos{std::begin(range)};
+        const auto end{std::end(range)};
+        for(size_t skip = _rows.size(); skip > 0Z && pos != end; --skip) {
+            ++pos;
+        }
+        for(; pos != end; ++pos) {
+            _append(*pos);
+        }
+    }
+
+    /// @brief Returns the number of the rows.
+    auto size() const noexcept -> size_t {
+        return _rows.size();
+    }
+
+    auto all() const -> metadata_selection {
+        return ~metadata_selection{_rows};
+    }
+
+    auto none() const -> metadata_selection {
+        return metadata_selection{_rows};
+    }
+
+    auto intersecting(const metadata_sequence& s) const -> metadata_selection {
+        std::vector<hash_t> ids;
+        ids.reserve(s.count());
+        for(const auto& md : s) {
+            ids.push_back(md.id());
+        }
+        std::sort(ids.begin(), ids.end());
+        return _scan([&](size_t i) {
+            return std::binary_search(ids.begin(), ids.end(), _rows[i]->id());
+        });
+    }
+
+    auto excluding(const metadata_sequence& s) const -> metadata_selection {
+        return ~intersecting(s);
+    }
+
+    auto having_all(meta_traits t) const -> metadata_selection {
+        return _scan_all(_meta_traits, t);
+    }
+
+    auto having(meta_traits t) const -> metadata_selection {
+        return _scan_some(_meta_traits, t);
+    }
+
+    auto not_having(meta_traits t) const -> metadata_selection {
+        return ~having(t);
+    }
+
+    auto having_all(type_traits t) const -> metadata_selection {
+        return _scan_all(_type_traits, t);
+    }
+
+    auto having(type_traits t) const -> metadata_selection {
+        return _scan_some(_type_traits, t);
+    }
+
+    auto not_having(type_traits t) const -> metadata_selection {
+        return ~having(t);
+    }
+
+    auto having_all(object_traits t) const -> metadata_selection {
+        const auto mask{t.bits()};
+        return _scan([&](size_t i) {
+            return (_op_boolean_results[i] & _op_boolean_applicable[i] &
+                    mask) == mask;
+        });
+    }
+
+    auto having(object_traits t) const -> metadata_selection {
+        const auto mask{t.bits()};
+        return _scan([&](size_t i) {
+            return (_op_boolean_results[i] & _op_boolean_applicable[i] &
+                    mask) != 0U;
+        });
+    }
+
+    auto not_having(object_traits t) const -> metadata_selection {
+        return ~having(t);
+    }
+
+    auto supporting(operations_boolean op) const -> metadata_selection {
+        return _scan_all(_op_boolean_applicable, op);
+    }
+
+    auto supporting(operations_integer op) const -> metadata_selection {
+        return _scan_all(_op_integer_applicable, op);
+    }
+
+    auto supporting(operations_string op) const -> metadata_selection {
+        return _scan_all(_op_string_applicable, op);
+    }
+
+    auto supporting(operations_metaobject op) const -> metadata_selection {
+        return _scan_all(_op_metaobject_applicable, op);
+    }
+
+    auto with_name() const -> metadata_selection {
+        return supporting(operation::get_name);
+    }
+};
+//------------------------------------------------------------------------------
+} // namespace mirror
+
+#endif // MIRROR_METADATA_QUERY_HPP
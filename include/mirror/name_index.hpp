@@ -0,0 +1,88 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef MIRROR_NAME_INDEX_HPP
+#define MIRROR_NAME_INDEX_HPP
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace mirror {
+
+/// @brief Hash index of a fixed set of names, usable at compile-time.
+/// @ingroup utilities
+///
+/// Maps each of the names to its position in the sequence it was constructed
+/// from. Lookups hash the searched string once and then in the typical case
+/// compare it with a single candidate, regardless of the number of names.
+template <std::size_t N>
+class name_index {
+public:
+    constexpr name_index(const std::array<std::string_view, N>& names) noexcept
+      : _names{names} {
+        for(std::size_t i = 0; i < N; ++i) {
+            std::size_t slot{_hash(names[i]) & _mask};
+            while(_slots[slot] != 0U) {
+                slot = (slot + 1U) & _mask;
+            }
+            _slots[slot] = std::uint32_t(i + 1U);
+        }
+    }
+
+    /// @brief Returns the number of names in the index.
+    constexpr auto size() const noexcept -> std::size_t {
+        return N;
+    }
+
+    /// @brief Returns the name at the specified position.
+    constexpr auto name(std::size_t index) const noexcept -> std::string_view {
+        return _names[index];
+    }
+
+    /// @brief Returns the position of the specified name if it is indexed.
+    constexpr auto find(std::string_view name) const noexcept
+      -> std::optional<std::size_t> {
+        for(std::size_t slot{_hash(name) & _mask};;
+            slot = (slot + 1U) & _mask) {
+            const std::size_t pos{_slots[slot]};
+            if(pos == 0U) {
+                return {};
+            }
+            if(_names[pos - 1U] == name) {
+                return {pos - 1U};
+            }
+        }
+    }
+
+private:
+    // more than twice the number of names so there always is an empty slot
+    static constexpr std::size_t _capacity{std::bit_ceil(2U * N + 1U)};
+    static constexpr std::size_t _mask{_capacity - 1U};
+
+    static constexpr auto _hash(std::string_view s) noexcept -> std::size_t {
+        std::uint64_t h{0xcbf29ce484222325ULL};
+        for(const char c : s) {
+            h ^= std::uint8_t(c);
+            h *= 0x100000001b3ULL;
+        }
+        return std::size_t(h ^ (h >> 32U));
+    }
+
+    std::array<std::string_view, N> _names{};
+    std::array<std::uint32_t, _capacity> _slots{};
+};
+
+template <std::size_t N>
+name_index(const std::array<std::string_view, N>&) -> name_index<N>;
+
+} // namespace mirror
+
+#endif // MIRROR_NAME_INDEX_HPP
@@ -207,6 +207,30 @@ consteval auto reflects_global_scope_member(wrapped_metaobject<M>) noexcept
     }
 }
 
+/// @brief Indicates if a metaobject reflects a member of the std namespace.
+/// @ingroup classification
+/// @see reflects_scope_member
+/// @see reflects_user_record
+/// @see get_scope
+/// The members of nested and inline namespaces and records in std count too.
+template <__metaobject_id M>
+consteval auto reflects_std_member(wrapped_metaobject<M>) noexcept -> bool {
+    if constexpr(__metaobject_is_meta_scope_member(M)) {
+        constexpr const auto S{__metaobject_get_scope(M)};
+        if constexpr(__metaobject_is_meta_global_scope(S)) {
+            return false;
+        } else if constexpr(
+          __metaobject_is_meta_namespace(S) &&
+          __metaobject_is_meta_global_scope(__metaobject_get_scope(S))) {
+            return __builtin_strcmp(__metaobject_get_name(S), "std") == 0;
+        } else {
+            return reflects_std_member(wrapped_metaobject<S>{});
+        }
+    } else {
+        return false;
+    }
+}
+
 /// @brief Indicates if a metaobject reflects an enumerator.
 /// @ingroup classification
 /// @see reflects_constant
@@ -327,6 +351,18 @@ consteval auto reflects_record(wrapped_metaobject<M>) noexcept -> bool {
     return __metaobject_is_meta_record(M);
 }
 
+/// @brief Indicates if a metaobject reflects a record not from the std library.
+/// @ingroup classification
+/// @see reflects_record
+/// @see reflects_std_member
+/// The values of such records can be processed member by member, while
+/// the standard library types should be used through their interfaces.
+template <__metaobject_id M>
+consteval auto reflects_user_record(wrapped_metaobject<M> mo) noexcept
+  -> bool {
+    return reflects_record(mo) && !reflects_std_member(mo);
+}
+
 /// @brief Indicates if a metaobject reflects a class.
 /// @ingroup classification
 /// @see reflects_type
@@ -11,11 +11,24 @@
 
 #include "base_type.hpp"
 #include "element_type.hpp"
+#include "full_name.hpp"
 #include "hash.hpp"
 #include "init_list.hpp"
 #include "metadata.hpp"
 #include "placeholder.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace mirror {
 
@@ -28,8 +41,8 @@ auto get_metadata(wrapped_metaobject<M>, metadata_registry&) noexcept
   -> stored_metadata&;
 
 class stored_metadata : public metadata {
-private:
-    static auto _get_op_boolean_results(auto mo) noexcept {
+protected:
+    static constexpr auto _get_op_boolean_results(auto mo) noexcept {
         return fold_init_list_of<operation_boolean>(
           filter(
             get_enumerators(mirror(object_trait)), mirror::try_apply(_1, mo)),
@@ -37,7 +50,7 @@ private:
           [](auto il) { return operations_boolean{il}; });
     }
 
-    static auto _get_op_boolean_applicable(auto mo) noexcept {
+    static constexpr auto _get_op_boolean_applicable(auto mo) noexcept {
         return fold_init_list_of<operation_boolean>(
           filter(
             get_enumerators(mirror(object_trait)),
@@ -46,7 +59,7 @@ private:
           [](auto il) { return operations_boolean{il}; });
     }
 
-    static auto _get_op_metaobject_applicable(auto mo) noexcept {
+    static constexpr auto _get_op_metaobject_applicable(auto mo) noexcept {
         return fold_init_list_of<operation_metaobject>(
           filter(
             get_enumerators(mirror(operation_metaobject)),
@@ -55,7 +68,7 @@ private:
           [](auto il) { return operations_metaobject{il}; });
     }
 
-    static auto _get_op_integer_applicable(auto mo) noexcept {
+    static constexpr auto _get_op_integer_applicable(auto mo) noexcept {
         return fold_init_list_of<operation_integer>(
           filter(
             get_enumerators(mirror(operation_integer)),
@@ -64,7 +77,7 @@ private:
           [](auto il) { return operations_integer{il}; });
     }
 
-    static auto _get_op_string_applicable(auto mo) noexcept {
+    static constexpr auto _get_op_string_applicable(auto mo) noexcept {
         return fold_init_list_of<operation_string>(
           filter(
             get_enumerators(mirror(operation_string)),
@@ -73,20 +86,38 @@ private:
           [](auto il) { return operations_string{il}; });
     }
 
-    static auto _get_name(auto mo) noexcept -> std::string_view {
+    static constexpr auto _get_name(auto mo) noexcept -> std::string_view {
         if constexpr(reflects_named(mo)) {
             return get_name(mo);
         }
         return {};
     }
 
-    static auto _get_display_name(auto mo) noexcept -> std::string_view {
+    static constexpr auto _get_display_name(auto mo) noexcept
+      -> std::string_view {
         if constexpr(reflects_named(mo)) {
             return get_display_name(mo);
         }
         return {};
     }
 
+    constexpr stored_metadata(auto mo, hash_t id, const metadata& none) noexcept
+      : metadata{
+          id,
+          get_traits(mo),
+          get_type_traits(mo),
+          _get_op_boolean_results(mo),
+          _get_op_boolean_applicable(mo),
+          _get_op_metaobject_applicable(mo),
+          _get_op_integer_applicable(mo),
+          _get_op_string_applicable(mo),
+          get_source_column(mo),
+          get_source_line(mo),
+          _get_name(mo),
+          _get_display_name(mo),
+          none} {}
+
+private:
     template <typename R, typename T>
     static constexpr auto
     _do_get_referenced_type(std::type_identity<T>, R& r) noexcept
@@ -145,10 +176,12 @@ private:
             if constexpr(mirror::is_applicable<O>(mo)) {
                 const auto ms = mirror::try_apply<O>(mo);
                 auto& md = get_metadata(ms, r);
-                pmd = &md;
+                // the linked metadata is complete before it is reachable,
+                // recursion ends at the already expanded sequences
                 if constexpr(!reflects_type(ms)) {
                     md.init(ms, r);
                 }
+                _store_link(pmd, md);
             }
         }
         return pmd;
@@ -161,8 +194,7 @@ private:
       const metadata*& pmd) -> const metadata* {
         if constexpr(reflects_type(mo)) {
             if(pmd->is_none()) {
-                auto& md = get_metadata(get_base_type(mo), r);
-                pmd = &md;
+                _store_link(pmd, get_metadata(get_base_type(mo), r));
             }
         } else if constexpr(reflects_typed(mo)) {
             return _try_init_base_type(get_type(mo), r, pmd);
@@ -176,30 +208,16 @@ private:
       metadata_registry& r,
       const metadata*& pmd) -> const metadata* {
         if(pmd->is_none()) {
-            auto& md = get_metadata(get_element_type(mo), r);
-            pmd = &md;
+            _store_link(pmd, get_metadata(get_element_type(mo), r));
         }
         return pmd;
     }
 
 public:
-    stored_metadata() noexcept = default;
+    constexpr stored_metadata() noexcept = default;
 
     stored_metadata(auto mo, hash_t id, metadata_registry& r) noexcept
-      : metadata{
-          id,
-          get_traits(mo),
-          get_type_traits(mo),
-          _get_op_boolean_results(mo),
-          _get_op_boolean_applicable(mo),
-          _get_op_metaobject_applicable(mo),
-          _get_op_integer_applicable(mo),
-          _get_op_string_applicable(mo),
-          get_source_column(mo),
-          get_source_line(mo),
-          _get_name(mo),
-          _get_display_name(mo),
-          get_no_metadata(r)} {
+      : stored_metadata{mo, id, get_no_metadata(r)} {
         if constexpr(reflects_type(mo)) {
             _try_init_element_type(mo, r, _element_type);
         }
@@ -234,70 +252,415 @@ public:
     }
 };
 
+// contiguous block storage, the elements are never moved. The published
+// elements can be read concurrently with the emplacing of new ones.
+class metadata_storage {
+private:
+    static constexpr const size_t _block_size{256Z};
+    // a full directory of blocks is replaced by a larger copy, but it is
+    // kept, because concurrent readers may still be using it
+    std::vector<std::unique_ptr<stored_metadata*[]>> _directories;
+    std::atomic<stored_metadata**> _blocks{nullptr};
+    size_t _block_count{0Z};
+    size_t _block_capacity{0Z};
+    size_t _size{0Z};
+    std::atomic<size_t> _published{0Z};
+
+    void _add_block() {
+        auto** blocks{_blocks.load(std::memory_order_relaxed)};
+        if(_block_count == _block_capacity) {
+            _block_capacity = _block_capacity ? 2Z * _block_capacity : 16Z;
+            auto& grown{_directories.emplace_back(
+              std::make_unique<stored_metadata*[]>(_block_capacity))};
+            std::copy_n(blocks, _block_count, grown.get());
+            blocks = grown.get();
+        }
+        blocks[_block_count++] =
+          std::allocator<stored_metadata>{}.allocate(_block_size);
+        _blocks.store(blocks, std::memory_order_release);
+    }
+
+public:
+    metadata_storage() noexcept = default;
+    metadata_storage(metadata_storage&&) = delete;
+    metadata_storage(const metadata_storage&) = delete;
+    auto operator=(metadata_storage&&) = delete;
+    auto operator=(const metadata_storage&) = delete;
+
+    ~metadata_storage() noexcept {
+        for(size_t i = _size; i > 0Z; --i) {
+            std::destroy_at(&(*this)[i - 1Z]);
+        }
+        auto** blocks{_blocks.load(std::memory_order_relaxed)};
+        for(size_t b = 0Z; b < _block_count; ++b) {
+            std::allocator<stored_metadata>{}.deallocate(
+              blocks[b], _block_size);
+        }
+    }
+
+    // the number of the published elements
+    auto size() const noexcept -> size_t {
+        return _published.load(std::memory_order_acquire);
+    }
+
+    auto operator[](size_t index) const noexcept -> stored_metadata& {
+        auto* const* blocks{_blocks.load(std::memory_order_acquire)};
+        return blocks[index / _block_size][index % _block_size];
+    }
+
+    template <typename... Args>
+    auto emplace(Args&&... args) -> stored_metadata& {
+        if(_size == _block_count * _block_size) {
+            _add_block();
+        }
+        auto* pos{&(*this)[_size]};
+        // the constructor may recursively emplace the related metadata
+        ++_size;
+        return *std::construct_at(pos, std::forward<Args>(args)...);
+    }
+
+    // makes all the emplaced elements visible to the readers
+    void publish() noexcept {
+        _published.store(_size, std::memory_order_release);
+    }
+};
+
+// open-addressing hash table mapping metaobject ids to stored metadata.
+// Lookups of published entries do not lock and can run concurrently with
+// an insertion. A full table is replaced by a larger copy and kept, like
+// the directory of the storage.
+class metadata_index {
+private:
+    struct _entry {
+        std::atomic<hash_t> id{0U};
+        std::atomic<stored_metadata*> pmd{nullptr};
+        std::atomic<bool> published{false};
+    };
+
+    struct _table {
+        std::vector<_entry> entries;
+
+        explicit _table(size_t capacity)
+          : entries(capacity) {}
+    };
+
+    std::vector<std::unique_ptr<_table>> _tables;
+    std::atomic<_table*> _current{nullptr};
+    std::vector<hash_t> _pending;
+    size_t _count{0Z};
+
+    static auto _home(hash_t id, size_t mask) noexcept -> size_t {
+        // the ids of metaobject sequences are combined with xor, mix them
+        id *= 0x9E3779B97F4A7C15ULL;
+        return size_t(id ^ (id >> 32U)) & mask;
+    }
+
+    static auto _find(_table& table, hash_t id) noexcept -> _entry* {
+        const size_t mask{table.entries.size() - 1Z};
+        for(size_t pos{_home(id, mask)};; pos = (pos + 1Z) & mask) {
+            auto& entry{table.entries[pos]};
+            if(!entry.pmd.load(std::memory_order_acquire)) {
+                return nullptr;
+            }
+            if(entry.id.load(std::memory_order_relaxed) == id) {
+                return &entry;
+            }
+        }
+    }
+
+    static void _place(
+      _table& table,
+      hash_t id,
+      stored_metadata* pmd,
+      bool published) noexcept {
+        const size_t mask{table.entries.size() - 1Z};
+        size_t pos{_home(id, mask)};
+        while(table.entries[pos].pmd.load(std::memory_order_relaxed)) {
+            pos = (pos + 1Z) & mask;
+        }
+        auto& entry{table.entries[pos]};
+        entry.id.store(id, std::memory_order_relaxed);
+        entry.published.store(published, std::memory_order_relaxed);
+        entry.pmd.store(pmd, std::memory_order_release);
+    }
+
+public:
+    metadata_index()
+      : _current{_tables.emplace_back(std::make_unique<_table>(64Z)).get()} {}
+
+    // finds published metadata, without locking
+    auto find(hash_t id) const noexcept -> stored_metadata* {
+        const auto* entry{_find(*_current.load(std::memory_order_acquire), id)};
+        if(entry && entry->published.load(std::memory_order_acquire)) {
+            return entry->pmd.load(std::memory_order_relaxed);
+        }
+        return nullptr;
+    }
+
+    // finds published or pending metadata, only for the inserting thread
+    auto find_any(hash_t id) const noexcept -> stored_metadata* {
+        const auto* entry{_find(*_current.load(std::memory_order_relaxed), id)};
+        return entry ? entry->pmd.load(std::memory_order_relaxed) : nullptr;
+    }
+
+    // inserts pending metadata, which is not found by find until published
+    void insert(hash_t id, stored_metadata& md) {
+        auto* table{_current.load(std::memory_order_relaxed)};
+        // keeps the load factor at or below one half
+        if(2Z * (_count + 1Z) > table->entries.size()) {
+            auto* grown{_tables
+                          .emplace_back(std::make_unique<_table>(
+                            2Z * table->entries.size()))
+                          .get()};
+            for(const auto& entry : table->entries) {
+                if(auto* pmd{entry.pmd.load(std::memory_order_relaxed)}) {
+                    _place(
+                      *grown,
+                      entry.id.load(std::memory_order_relaxed),
+                      pmd,
+                      entry.published.load(std::memory_order_relaxed));
+                }
+            }
+            _current.store(grown, std::memory_order_release);
+            table = grown;
+        }
+        _place(*table, id, &md, false);
+        _pending.push_back(id);
+        ++_count;
+    }
+
+    // makes the pending metadata visible to find
+    void publish() noexcept {
+        auto& table{*_current.load(std::memory_order_relaxed)};
+        for(const auto id : _pending) {
+            _find(table, id)->published.store(true, std::memory_order_release);
+        }
+        _pending.clear();
+    }
+};
+
+// secondary indexes mapping the names and the fully qualified names to the
+// metadata. The qualified names are ordered, so that the names starting with
+// the same prefix, like the members of a scope, form a contiguous range.
+// As in the metadata_index, the inserted entries are found only after they
+// are published. Lookups share a lock taken exclusively only by publish.
+class metadata_name_index {
+private:
+    struct _pending_entry {
+        std::string_view name;
+        std::string full_name;
+        const metadata* pmd;
+    };
+
+    mutable std::shared_mutex _mutex;
+    std::unordered_map<std::string_view, std::vector<const metadata*>>
+      _by_name;
+    std::multimap<std::string, const metadata*, std::less<>> _by_full_name;
+    std::vector<_pending_entry> _pending;
+
+    // indicates if the name has a scope separator outside of any template
+    // argument list or parentheses
+    static auto _is_nested(std::string_view name) noexcept -> bool {
+        int depth{0};
+        for(size_t i = 0Z; i < name.size(); ++i) {
+            const char c{name[i]};
+            if(c == '<' || c == '(') {
+                ++depth;
+            } else if((c == '>' || c == ')') && depth > 0) {
+                --depth;
+            } else if(depth == 0 && name.substr(i).starts_with("::")) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    // inserts pending entries, the empty names are not indexed
+    void insert(
+      std::string_view name,
+      std::string full_name,
+      const metadata& md) {
+        if(!name.empty() || !full_name.empty()) {
+            _pending.push_back({name, std::move(full_name), &md});
+        }
+    }
+
+    // makes the pending entries visible to the lookups
+    void publish() {
+        if(_pending.empty()) {
+            return;
+        }
+        const std::unique_lock lock{_mutex};
+        for(auto& entry : _pending) {
+            if(!entry.name.empty()) {
+                _by_name[entry.name].push_back(entry.pmd);
+            }
+            if(!entry.full_name.empty()) {
+                _by_full_name.emplace(std::move(entry.full_name), entry.pmd);
+            }
+        }
+        _pending.clear();
+    }
+
+    // finds the first metadata registered with the qualified name
+    auto find(std::string_view full_name) const noexcept -> const metadata* {
+        const std::shared_lock lock{_mutex};
+        const auto pos{_by_full_name.lower_bound(full_name)};
+        if(pos != _by_full_name.end() && pos->first == full_name) {
+            return pos->second;
+        }
+        return nullptr;
+    }
+
+    auto with_name(std::string_view name) const
+      -> std::vector<const metadata*> {
+        const std::shared_lock lock{_mutex};
+        const auto pos{_by_name.find(name)};
+        if(pos != _by_name.end()) {
+            return pos->second;
+        }
+        return {};
+    }
+
+    auto with_full_name(std::string_view full_name) const
+      -> std::vector<const metadata*> {
+        const std::shared_lock lock{_mutex};
+        std::vector<const metadata*> result;
+        const auto [begin, end]{_by_full_name.equal_range(full_name)};
+        for(auto pos = begin; pos != end; ++pos) {
+            result.push_back(pos->second);
+        }
+        return result;
+    }
+
+    auto with_prefix(std::string_view prefix) const
+      -> std::vector<const metadata*> {
+        const std::shared_lock lock{_mutex};
+        std::vector<const metadata*> result;
+        for(auto pos{_by_full_name.lower_bound(prefix)};
+            pos != _by_full_name.end() && pos->first.starts_with(prefix);
+            ++pos) {
+            result.push_back(pos->second);
+        }
+        return result;
+    }
+
+    // like with_prefix, but skips the names nested deeper after the prefix
+    auto with_direct_prefix(std::string_view prefix) const
+      -> std::vector<const metadata*> {
+        const std::shared_lock lock{_mutex};
+        std::vector<const metadata*> result;
+        for(auto pos{_by_full_name.lower_bound(prefix)};
+            pos != _by_full_name.end() && pos->first.starts_with(prefix);
+            ++pos) {
+            const std::string_view full_name{pos->first};
+            if(!_is_nested(full_name.substr(prefix.size()))) {
+                result.push_back(pos->second);
+            }
+        }
+        return result;
+    }
+};
+
 class metadata_registry_iterator {
 private:
-    using base_iter_t =
-      std::map<hash_t, std::unique_ptr<stored_metadata>>::const_iterator;
-    base_iter_t _iter{};
+    const metadata_storage* _storage{nullptr};
+    size_t _index{0Z};
 
 public:
     using value_type = const metadata;
     using pointer = const metadata*;
     using reference = const metadata&;
-    using difference_type = base_iter_t::difference_type;
+    using difference_type = std::ptrdiff_t;
     using iterator_category = std::forward_iterator_tag;
 
-    metadata_registry_iterator(base_iter_t iter) noexcept
-      : _iter{iter} {}
+    metadata_registry_iterator(
+      const metadata_storage& storage,
+      size_t index) noexcept
+      : _storage{&storage}
+      , _index{index} {}
 
     friend auto operator==(
       const metadata_registry_iterator& l,
       const metadata_registry_iterator& r) noexcept -> bool {
-        return l._iter == r._iter;
+        return l._index == r._index;
     }
 
     friend auto operator!=(
       const metadata_registry_iterator& l,
       const metadata_registry_iterator& r) noexcept -> bool {
-        return l._iter != r._iter;
+        return l._index != r._index;
     }
 
     auto operator++() noexcept -> auto& {
-        ++_iter;
+        ++_index;
         return *this;
     }
 
     auto operator++(int) noexcept -> auto {
         auto copy{*this};
-        ++_iter;
+        ++_index;
         return copy;
     }
 
     auto operator*() noexcept -> const metadata& {
-        return *_iter->second;
+        return (*_storage)[_index];
     }
 };
 
+// Metadata can be looked up and registered from multiple threads. Lookups
+// of published metadata do not lock. Registrations, which are recursive,
+// are serialized by a mutex and the metadata registered by them is published
+// when the outermost registration finishes. Adding a type that was already
+// registered as related to other metadata completes its links, these are
+// stored atomically after the linked metadata is complete, so they can be
+// followed concurrently.
 class metadata_registry {
 private:
-    std::map<hash_t, std::unique_ptr<stored_metadata>> _metadata;
+    metadata_storage _storage;
+    metadata_index _index;
+    metadata_name_index _names;
+    std::recursive_mutex _mutex;
+    size_t _depth{0Z};
 
     friend auto get_no_metadata(metadata_registry& r) noexcept
       -> const metadata& {
         return r.get_none();
     }
 
+    void _finish_registration() noexcept {
+        if(--_depth == 0Z) {
+            _storage.publish();
+            _index.publish();
+            _names.publish();
+        }
+    }
+
+    static auto _get_full_name(auto mo) -> std::string {
+        if constexpr(reflects_named(mo)) {
+            return get_full_name(mo);
+        }
+        return {};
+    }
+
     template <__metaobject_id M>
     auto _get(wrapped_metaobject<M> mo) noexcept -> stored_metadata& {
-        const auto id = get_hash(mo);
-        auto pos = _metadata.find(id);
-        if(pos == _metadata.end()) {
-            pos =
-              _metadata
-                .emplace(id, std::make_unique<stored_metadata>(mo, id, *this))
-                .first;
+        // computed during compilation, the lookup does not allocate
+        constexpr const hash_t id{get_hash(wrapped_metaobject<M>{})};
+        if(auto* pmd = _index.find(id)) {
+            return *pmd;
         }
-        return *pos->second;
+        const std::lock_guard lock{_mutex};
+        ++_depth;
+        auto* pmd = _index.find_any(id);
+        if(!pmd) {
+            pmd = &_storage.emplace(mo, id, *this);
+            _index.insert(id, *pmd);
+            _names.insert(pmd->name_(), _get_full_name(mo), *pmd);
+        }
+        _finish_registration();
+        return *pmd;
     }
 
     template <__metaobject_id M>
@@ -308,41 +671,46 @@ private:
     }
 
     auto _find(metaobject auto mo) -> stored_metadata& {
-        const auto id = get_hash(mo);
-        auto pos = _metadata.find(id);
-        if(pos == _metadata.end()) {
+        constexpr const hash_t id{get_hash(decltype(mo){})};
+        auto* pmd = _index.find(id);
+        if(!pmd) {
             throw metadata_not_found();
         }
-        return *pos->second;
+        return *pmd;
     }
 
     template <__metaobject_id M>
     auto _add(wrapped_metaobject<M> mo) noexcept -> stored_metadata& {
+        const std::lock_guard lock{_mutex};
+        ++_depth;
         auto& md = _get(mo);
         md.init(mo, *this);
+        _finish_registration();
         return md;
     }
 
 public:
     metadata_registry() noexcept {
-        _metadata.emplace(
-          get_hash(no_metaobject), std::make_unique<stored_metadata>());
+        _index.insert(get_hash(no_metaobject), _storage.emplace());
+        _storage.publish();
+        _index.publish();
     }
 
     auto size() const noexcept {
-        return _metadata.size();
+        return _storage.size();
     }
 
     auto begin() const noexcept -> metadata_registry_iterator {
-        return {_metadata.begin()};
+        return {_storage, 0Z};
     }
 
     auto end() const noexcept -> metadata_registry_iterator {
-        return {_metadata.end()};
+        return {_storage, _storage.size()};
     }
 
     auto get_none() noexcept -> const metadata& {
-        return *_metadata[get_hash(no_metaobject)];
+        // the empty metadata is always stored first
+        return _storage[0Z];
     }
 
     auto add(metaobject auto mo) noexcept -> const metadata& {
@@ -353,22 +721,65 @@ public:
         return _find(mo);
     }
 
+    // finds metadata by its fully qualified name, like "example::weekday"
+    auto find(std::string_view full_name) const -> const metadata& {
+        if(const auto* pmd{_names.find(full_name)}) {
+            return *pmd;
+        }
+        throw metadata_not_found();
+    }
+
+    auto find_by_name(std::string_view name) const -> metadata_sequence {
+        return {_names.with_name(name)};
+    }
+
+    // all the metadata with the fully qualified name, like overloads
+    auto find_by_full_name(std::string_view full_name) const
+      -> metadata_sequence {
+        return {_names.with_full_name(full_name)};
+    }
+
+    // the metadata with the qualified names starting with the prefix, sorted
+    // by the names. This is plain string matching, with a "scope::" prefix
+    // these are all the descendants of the scope, including the members of
+    // nested scopes, and without the trailing "::" also the sibling names
+    // that start with the name of the scope
+    auto find_by_prefix(std::string_view prefix) const -> metadata_sequence {
+        return {_names.with_prefix(prefix)};
+    }
+
+    // the registered members declared directly in the scope with the fully
+    // qualified name, like "example::cards", sorted by their names. An empty
+    // name selects the members of the global scope
+    auto find_scope_members(std::string_view scope_name) const
+      -> metadata_sequence {
+        if(scope_name.empty()) {
+            return {_names.with_direct_prefix({})};
+        }
+        std::string prefix{scope_name};
+        prefix.append("::");
+        return {_names.with_direct_prefix(prefix)};
+    }
+
     auto all() const -> metadata_sequence {
+        const size_t count{_storage.size()};
         std::vector<const metadata*> elements;
-        elements.reserve(_metadata.size());
-        for(const auto& p : _metadata) {
-            elements.push_back(std::get<1>(p).get());
+        elements.reserve(count);
+        for(size_t i = 0Z; i < count; ++i) {
+            elements.push_back(&_storage[i]);
         }
         return {elements};
     }
 
     template <typename F>
     auto filtered(F predicate) const -> metadata_sequence {
+        const size_t count{_storage.size()};
         std::vector<const metadata*> elements;
-        elements.reserve(_metadata.size());
-        for(const auto& p : _metadata) {
-            if(predicate(*std::get<1>(p))) {
-                elements.push_back(std::get<1>(p).get());
+        elements.reserve(count);
+        for(size_t i = 0Z; i < count; ++i) {
+            const auto& md{_storage[i]};
+            if(predicate(md)) {
+                elements.push_back(&md);
             }
         }
         return {elements};
@@ -0,0 +1,364 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef MIRROR_SERIALIZE_COLUMNAR_HPP
+#define MIRROR_SERIALIZE_COLUMNAR_HPP
+
+#include "../name_index.hpp"
+#include "read.hpp"
+#include "write.hpp"
+#include <array>
+#include <bitset>
+#include <memory>
+#include <new>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mirror::serialize {
+//------------------------------------------------------------------------------
+/// @brief Selects the columnar (struct-of-arrays) encoding of a record vector.
+/// @ingroup serialization
+/// @see as_columns
+///
+/// Wraps a reference to a vector of records. When serialized, the vector is
+/// written as a single record having the same attributes as the element type,
+/// where each attribute holds the list of the values of that data member in
+/// all elements. The member names are thus written only once and the values
+/// of each member are stored contiguously, so columns of arithmetic types can
+/// take the bulk path of backends supporting it.
+template <typename Records>
+class columnar {
+public:
+    constexpr columnar(Records& records) noexcept
+      : _records{records} {}
+
+    /// @brief Returns a reference to the wrapped vector of records.
+    constexpr auto records() const noexcept -> Records& {
+        return _records;
+    }
+
+private:
+    Records& _records;
+};
+//------------------------------------------------------------------------------
+/// @brief Wraps the specified vector of records for columnar serialization.
+/// @ingroup serialization
+/// @see columnar
+///
+/// The returned wrapper can be written directly, but reading requires
+/// a non-const lvalue, so store the wrapper in a variable first and pass
+/// that variable to read or read_binary.
+template <typename T, typename A>
+constexpr auto as_columns(std::vector<T, A>& records) noexcept
+  -> columnar<std::vector<T, A>> {
+    return {records};
+}
+
+/// @brief Wraps the specified vector of records for columnar serialization.
+/// @ingroup serialization
+/// @see columnar
+template <typename T, typename A>
+constexpr auto as_columns(const std::vector<T, A>& records) noexcept
+  -> columnar<const std::vector<T, A>> {
+    return {records};
+}
+//------------------------------------------------------------------------------
+template <typename T, typename A>
+struct serializer<columnar<const std::vector<T, A>>> {
+private:
+    template <write_backend Backend>
+    static auto _write_column(
+      const write_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      const std::vector<T, A>& records,
+      metaobject auto mdm) noexcept -> write_errors {
+        using M = std::remove_cvref_t<decltype(get_value(mdm, records[0Z]))>;
+        write_errors errors{};
+        auto subctx{backend.begin_list(ctx, records.size())};
+        if(MIRROR_LIKELY(has_value(subctx))) {
+            if constexpr(bulk_write_backend<Backend, M>) {
+                // gather the strided member values into a contiguous column
+                const std::unique_ptr<M[]> column{
+                  new(std::nothrow) M[records.size()]};
+                if(MIRROR_LIKELY(column)) {
+                    for(size_t idx = 0; idx < records.size(); ++idx) {
+                        column[idx] = get_value(mdm, records[idx]);
+                    }
+                    errors |= backend.write_elements(
+                      extract(subctx),
+                      std::span<const M>(column.get(), records.size()));
+                } else {
+                    errors |= write_error_code::data_sink_error;
+                }
+            } else {
+                size_t idx = 0;
+                bool first = true;
+                for(const auto& record : records) {
+                    if(first) {
+                        first = false;
+                    } else {
+                        errors |= backend.separate_element(extract(subctx));
+                    }
+                    auto subsubctx{
+                      backend.begin_element(extract(subctx), idx)};
+                    errors |= driver.write(
+                      backend, extract(subsubctx), get_value(mdm, record));
+                    errors |= backend.finish_element(extract(subsubctx), idx);
+                    ++idx;
+                }
+            }
+            errors |= backend.finish_list(extract(subctx));
+        } else {
+            errors |= std::get<write_errors>(subctx);
+        }
+        return errors;
+    }
+
+public:
+    template <write_backend Backend>
+    auto write(
+      const write_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      const columnar<const std::vector<T, A>>& value) const noexcept
+      -> write_errors {
+        const auto& records{value.records()};
+        write_errors errors{};
+        const auto mdms{
+          filter(get_data_members(mirror(T)), not_(is_static(_1)))};
+        auto subctx{backend.begin_record(ctx, get_size(mdms))};
+        if(has_value(subctx)) {
+            bool first = true;
+            for_each(mdms, [&](auto mdm) {
+                if(first) {
+                    first = false;
+                } else {
+                    errors |= backend.separate_attribute(extract(subctx));
+                }
+                const auto name{get_name(mdm)};
+                auto subsubctx{backend.begin_attribute(extract(subctx), name)};
+                if(has_value(subsubctx)) {
+                    errors |= _write_column(
+                      driver, backend, extract(subsubctx), records, mdm);
+                    errors |=
+                      backend.finish_attribute(extract(subsubctx), name);
+                } else {
+                    errors |= std::get<write_errors>(subsubctx);
+                }
+            });
+            errors |= backend.finish_record(extract(subctx));
+        } else {
+            errors |= std::get<write_errors>(subctx);
+        }
+        return errors;
+    }
+};
+//------------------------------------------------------------------------------
+template <typename T, typename A>
+struct serializer<columnar<std::vector<T, A>>>
+  : serializer<columnar<const std::vector<T, A>>> {
+    template <write_backend Backend>
+    auto write(
+      const write_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      const columnar<std::vector<T, A>>& value) const noexcept
+      -> write_errors {
+        return serializer<columnar<const std::vector<T, A>>>::write(
+          driver, backend, ctx, as_columns(std::as_const(value.records())));
+    }
+};
+//------------------------------------------------------------------------------
+template <typename T, typename A>
+struct deserializer<columnar<std::vector<T, A>>> {
+private:
+    // the first column read determines the number of records, the lengths
+    // of the following ones are checked against it
+    template <read_backend Backend>
+    static auto _read_column(
+      const read_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      std::vector<T, A>& records,
+      bool& sized,
+      metaobject auto mdm) noexcept -> read_errors {
+        using M =
+          std::remove_cvref_t<decltype(get_reference(mdm, records[0Z]))>;
+        read_errors errors{};
+        size_t size{0Z};
+        const auto subctx{backend.begin_list(ctx, size)};
+        if(MIRROR_LIKELY(has_value(subctx))) {
+            if(!sized) {
+                records.resize(size);
+                sized = true;
+            }
+            if(MIRROR_UNLIKELY(size < records.size())) {
+                errors |= read_error_code::missing_element;
+            } else if(MIRROR_UNLIKELY(size > records.size())) {
+                errors |= read_error_code::excess_element;
+            } else if constexpr(bulk_read_backend<Backend, M>) {
+                const std::unique_ptr<M[]> column{new(std::nothrow) M[size]};
+                if(MIRROR_LIKELY(column)) {
+                    errors |= backend.read_elements(
+                      extract(subctx), std::span<M>(column.get(), size));
+                    for(size_t idx = 0; idx < size; ++idx) {
+                        get_reference(mdm, records[idx]) = column[idx];
+                    }
+                } else {
+                    errors |= read_error_code::data_source_error;
+                }
+            } else {
+                size_t idx = 0;
+                bool first = true;
+                for(auto& record : records) {
+                    if(first) {
+                        first = false;
+                    } else {
+                        errors |= backend.separate_element(extract(subctx));
+                    }
+                    const auto subsubctx{
+                      backend.begin_element(extract(subctx), idx)};
+                    errors |= driver.read(
+                      backend, extract(subsubctx), get_reference(mdm, record));
+                    errors |= backend.finish_element(extract(subctx), idx);
+                    ++idx;
+                }
+            }
+            errors |= backend.finish_list(extract(subctx));
+        } else {
+            errors |= std::get<read_errors>(subctx);
+        }
+        return errors;
+    }
+
+    template <read_backend Backend, __metaobject_id M>
+    static auto _read_member_column(
+      const read_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      std::vector<T, A>& records,
+      bool& sized) noexcept -> read_errors {
+        return _read_column(
+          driver, backend, ctx, records, sized, wrapped_metaobject<M>{});
+    }
+
+    // visits the columns in the order of the input, like the records do
+    template <attribute_iterating_read_backend Backend, __metaobject_id... M>
+    auto _do_read_columns(
+      const read_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      std::vector<T, A>& records,
+      unpacked_metaobject_sequence<M...>) const noexcept -> read_errors {
+        using reader_t = read_errors (*)(
+          const read_driver&,
+          Backend&,
+          typename Backend::context_param,
+          std::vector<T, A>&,
+          bool&);
+        static constexpr name_index<sizeof...(M)> index{
+          {{get_name(wrapped_metaobject<M>{})...}}};
+        static constexpr std::array<reader_t, sizeof...(M)> readers{
+          {&_read_member_column<Backend, M>...}};
+
+        read_errors errors{};
+        size_t count{sizeof...(M)};
+        auto subctx{backend.begin_record(ctx, count)};
+        if(MIRROR_LIKELY(has_value(subctx))) {
+            std::bitset<sizeof...(M)> found{};
+            bool sized = false;
+            while(backend.has_next_attribute(extract(subctx))) {
+                std::string_view name;
+                auto subsubctx{backend.next_attribute(extract(subctx), name)};
+                if(MIRROR_UNLIKELY(!has_value(subsubctx))) {
+                    errors |= std::get<read_errors>(subsubctx);
+                    break;
+                }
+                if(const auto pos{index.find(name)}) {
+                    errors |= readers[*pos](
+                      driver, backend, extract(subsubctx), records, sized);
+                    found.set(*pos);
+                } else {
+                    errors |= read_error_code::excess_member;
+                }
+                errors |= backend.finish_attribute(extract(subsubctx), name);
+            }
+            if(!found.all()) {
+                errors |= read_error_code::missing_member;
+            }
+            errors |= backend.finish_record(extract(subctx));
+        } else {
+            errors |= std::get<read_errors>(subctx);
+        }
+        return errors;
+    }
+
+public:
+    template <read_backend Backend>
+    auto read(
+      const read_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      columnar<std::vector<T, A>>& value) const noexcept -> read_errors {
+        auto& records{value.records()};
+        const auto mdms{
+          filter(get_data_members(mirror(T)), not_(is_static(_1)))};
+        if constexpr(attribute_iterating_read_backend<Backend>) {
+            return _do_read_columns(driver, backend, ctx, records, mdms);
+        } else {
+            read_errors errors{};
+            size_t count{get_size(mdms)};
+            auto subctx{backend.begin_record(ctx, count)};
+
+            if(count > get_size(mdms)) {
+                errors |= read_error_code::excess_member;
+            } else if(count < get_size(mdms)) {
+                errors |= read_error_code::missing_member;
+            }
+            if(has_value(subctx)) {
+                bool first = true;
+                bool sized = false;
+                for_each(mdms, [&](auto mdm) {
+                    if(first) {
+                        first = false;
+                    } else {
+                        errors |= backend.separate_attribute(extract(subctx));
+                    }
+                    const auto name{get_name(mdm)};
+                    auto subsubctx{
+                      backend.begin_attribute(extract(subctx), name)};
+                    if(has_value(subsubctx)) {
+                        errors |= _read_column(
+                          driver,
+                          backend,
+                          extract(subsubctx),
+                          records,
+                          sized,
+                          mdm);
+                        errors |=
+                          backend.finish_attribute(extract(subsubctx), name);
+                    } else {
+                        errors |= std::get<read_errors>(subsubctx);
+                    }
+                });
+                errors |= backend.finish_record(extract(subctx));
+            } else {
+                errors |= std::get<read_errors>(subctx);
+            }
+            return errors;
+        }
+    }
+};
+//------------------------------------------------------------------------------
+} // namespace mirror::serialize
+
+#endif // MIRROR_SERIALIZE_COLUMNAR_HPP
@@ -0,0 +1,185 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef MIRROR_SERIALIZE_DATA_SINK_HPP
+#define MIRROR_SERIALIZE_DATA_SINK_HPP
+
+#include "../branch_predict.hpp"
+#include "result.hpp"
+#include "resume.hpp"
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace mirror::serialize {
+//------------------------------------------------------------------------------
+/// @brief Concept constraining sinks of raw serialized bytes.
+/// @ingroup serialization
+/// @see span_data_sink
+/// @see buffer_data_sink
+/// @see chunked_data_sink
+/// @see counting_data_sink
+template <typename T>
+concept data_sink = requires(T v) {
+    { v.append(std::declval<std::span<const std::byte>>()) }
+    ->std::same_as<write_errors>;
+};
+//------------------------------------------------------------------------------
+/// @brief Concept constraining data sinks following the nesting of values.
+/// @ingroup serialization
+/// @see resume_tracker
+///
+/// The backends report the structure of the values written into such sinks
+/// to their tracker, so that an incomplete write can be resumed at the element
+/// where it stopped. The stream position counts the bytes from the start of
+/// the output, including those written in previous attempts.
+template <typename T>
+concept tracking_data_sink = data_sink<T> && requires(T v) {
+    { v.tracker() } -> std::same_as<resume_tracker&>;
+    { v.stream_position() } -> std::convertible_to<size_t>;
+};
+//------------------------------------------------------------------------------
+/// @brief Data sink writing into a caller-provided fixed-size block of memory.
+/// @ingroup serialization
+/// @see buffer_data_sink
+class span_data_sink {
+public:
+    span_data_sink(std::span<std::byte> dest) noexcept
+      : _dest{dest} {}
+
+    /// @brief Appends the specified bytes, fails if they do not fit.
+    auto append(std::span<const std::byte> bytes) noexcept -> write_errors {
+        if(MIRROR_UNLIKELY(bytes.size() > _dest.size() - _done)) {
+            return {write_error_code::too_much_data};
+        }
+        std::memcpy(_dest.data() + _done, bytes.data(), bytes.size());
+        _done += bytes.size();
+        return {};
+    }
+
+    /// @brief Returns the number of bytes written so far.
+    auto size() const noexcept -> size_t {
+        return _done;
+    }
+
+    /// @brief Returns the part of the destination written so far.
+    auto done() const noexcept -> std::span<std::byte> {
+        return _dest.first(_done);
+    }
+
+    /// @brief Rewinds the sink to the start of the destination.
+    void reset() noexcept {
+        _done = 0Z;
+    }
+
+private:
+    std::span<std::byte> _dest;
+    size_t _done{0Z};
+};
+//------------------------------------------------------------------------------
+/// @brief Data sink appending to the end of a growable byte container.
+/// @ingroup serialization
+/// @see span_data_sink
+template <typename Container = std::vector<std::byte>>
+class buffer_data_sink {
+public:
+    buffer_data_sink(Container& dest) noexcept
+      : _dest{dest} {}
+
+    /// @brief Appends the specified bytes to the end of the container.
+    auto append(std::span<const std::byte> bytes) noexcept -> write_errors {
+        try {
+            _dest.insert(_dest.end(), bytes.begin(), bytes.end());
+        } catch(...) {
+            return {write_error_code::data_sink_error};
+        }
+        return {};
+    }
+
+    /// @brief Returns the number of bytes in the container.
+    auto size() const noexcept -> size_t {
+        return _dest.size();
+    }
+
+private:
+    Container& _dest;
+};
+//------------------------------------------------------------------------------
+/// @brief Data sink writing one bounded chunk of a longer byte stream.
+/// @ingroup serialization
+/// @see span_data_sink
+///
+/// The first @p skip bytes of the stream, which were already written into
+/// the previous chunks, are dropped without being copied. The following bytes
+/// are copied into the destination until it is full, after which any further
+/// appends fail with write_error_code::incomplete_write.
+class chunked_data_sink {
+public:
+    chunked_data_sink(std::span<std::byte> dest, size_t skip) noexcept
+      : _dest{dest}
+      , _skip{skip} {}
+
+    /// @brief Appends the part of the specified bytes that fits into the chunk.
+    auto append(std::span<const std::byte> bytes) noexcept -> write_errors {
+        if(_skip >= bytes.size()) {
+            _skip -= bytes.size();
+            return {};
+        }
+        bytes = bytes.subspan(_skip);
+        _skip = 0Z;
+        const size_t size{std::min(bytes.size(), _dest.size() - _done)};
+        std::memcpy(_dest.data() + _done, bytes.data(), size);
+        _done += size;
+        if(MIRROR_UNLIKELY(size < bytes.size())) {
+            return {write_error_code::incomplete_write};
+        }
+        return {};
+    }
+
+    /// @brief Returns the number of bytes written into this chunk.
+    auto size() const noexcept -> size_t {
+        return _done;
+    }
+
+    /// @brief Returns the part of the destination written so far.
+    auto done() const noexcept -> std::span<std::byte> {
+        return _dest.first(_done);
+    }
+
+private:
+    std::span<std::byte> _dest;
+    size_t _skip{0Z};
+    size_t _done{0Z};
+};
+//------------------------------------------------------------------------------
+/// @brief Data sink that only counts the bytes appended to it.
+/// @ingroup serialization
+/// @see serialized_size
+class counting_data_sink {
+public:
+    /// @brief Adds the number of the specified bytes to the total.
+    auto append(std::span<const std::byte> bytes) noexcept -> write_errors {
+        _done += bytes.size();
+        return {};
+    }
+
+    /// @brief Returns the number of bytes appended so far.
+    auto size() const noexcept -> size_t {
+        return _done;
+    }
+
+private:
+    size_t _done{0Z};
+};
+//------------------------------------------------------------------------------
+} // namespace mirror::serialize
+
+#endif // MIRROR_SERIALIZE_DATA_SINK_HPP
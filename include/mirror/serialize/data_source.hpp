@@ -0,0 +1,133 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef MIRROR_SERIALIZE_DATA_SOURCE_HPP
+#define MIRROR_SERIALIZE_DATA_SOURCE_HPP
+
+#include "../branch_predict.hpp"
+#include "result.hpp"
+#include "resume.hpp"
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+namespace mirror::serialize {
+//------------------------------------------------------------------------------
+/// @brief Concept constraining sources of raw serialized bytes.
+/// @ingroup serialization
+/// @see span_data_source
+template <typename T>
+concept data_source = requires(T v) {
+    { v.fetch(std::declval<size_t>()) }
+    ->std::convertible_to<std::span<const std::byte>>;
+};
+//------------------------------------------------------------------------------
+/// @brief Concept constraining data sources that may run dry before the end.
+/// @ingroup serialization
+/// @see chunked_data_source
+///
+/// If such a source cannot provide the requested data and @c is_dry returns
+/// true, then the rest of the input did not arrive yet and the read should be
+/// retried later, instead of treating the input as truncated. The reader then
+/// calls @c stall, after which all the fetches fail until the retry, so that
+/// no more values are decoded from the input following the missing part.
+template <typename T>
+concept resumable_data_source = data_source<T> && requires(T v) {
+    { v.is_dry() } -> std::convertible_to<bool>;
+    v.stall();
+};
+//------------------------------------------------------------------------------
+/// @brief Concept constraining data sources following the nesting of values.
+/// @ingroup serialization
+/// @see resume_tracker
+///
+/// The backends report the structure of the values read from such sources
+/// to their tracker, so that an incomplete read can be resumed at the element
+/// where it stopped. The stream position counts the bytes from the start of
+/// the input, including those that arrived in previous attempts.
+template <typename T>
+concept tracking_data_source = resumable_data_source<T> && requires(T v) {
+    { v.tracker() } -> std::same_as<resume_tracker&>;
+    { v.stream_position() } -> std::convertible_to<size_t>;
+};
+//------------------------------------------------------------------------------
+/// @brief Data source reading from a caller-provided block of memory.
+/// @ingroup serialization
+class span_data_source {
+public:
+    span_data_source(std::span<const std::byte> src) noexcept
+      : _src{src} {}
+
+    /// @brief Returns a view of the next @p size bytes and advances past them.
+    /// If there is not enough data left, returns an empty span and does not
+    /// advance, so the caller should compare the size of the result.
+    auto fetch(size_t size) noexcept -> std::span<const std::byte> {
+        if(MIRROR_UNLIKELY(size > _src.size() - _done)) {
+            return {};
+        }
+        const auto result{_src.subspan(_done, size)};
+        _done += size;
+        return result;
+    }
+
+    /// @brief Returns the number of bytes consumed so far.
+    auto position() const noexcept -> size_t {
+        return _done;
+    }
+
+    /// @brief Returns the number of bytes not consumed yet.
+    auto remaining() const noexcept -> size_t {
+        return _src.size() - _done;
+    }
+
+    /// @brief Rewinds the source to the start of the input.
+    void reset() noexcept {
+        _done = 0Z;
+    }
+
+private:
+    std::span<const std::byte> _src;
+    size_t _done{0Z};
+};
+//------------------------------------------------------------------------------
+/// @brief Data source reading the part of the input that arrived so far.
+/// @ingroup serialization
+/// @see span_data_source
+class chunked_data_source : public span_data_source {
+public:
+    chunked_data_source(std::span<const std::byte> src, bool complete) noexcept
+      : span_data_source{src}
+      , _complete{complete} {}
+
+    /// @brief Returns a view of the next @p size bytes and advances past them.
+    /// Returns an empty span if there is not enough data or if stalled.
+    auto fetch(size_t size) noexcept -> std::span<const std::byte> {
+        if(MIRROR_UNLIKELY(_stalled)) {
+            return {};
+        }
+        return span_data_source::fetch(size);
+    }
+
+    /// @brief Indicates that more of the input is going to arrive later.
+    auto is_dry() const noexcept -> bool {
+        return !_complete;
+    }
+
+    /// @brief Makes all the following fetches fail.
+    void stall() noexcept {
+        _stalled = true;
+    }
+
+private:
+    bool _complete{false};
+    bool _stalled{false};
+};
+//------------------------------------------------------------------------------
+} // namespace mirror::serialize
+
+#endif // MIRROR_SERIALIZE_DATA_SOURCE_HPP
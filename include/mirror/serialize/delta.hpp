@@ -0,0 +1,385 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef MIRROR_SERIALIZE_DELTA_HPP
+#define MIRROR_SERIALIZE_DELTA_HPP
+
+#include "read.hpp"
+#include "write.hpp"
+#include <array>
+#include <concepts>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mirror::serialize {
+//------------------------------------------------------------------------------
+template <typename T>
+consteval auto _reflects_delta_record() noexcept -> bool {
+    if constexpr(std::is_class_v<T>) {
+        return reflects_user_record(mirror(T));
+    } else {
+        return false;
+    }
+}
+
+/// @brief Indicates if deltas of values of type T are computed member-wise.
+/// @ingroup serialization
+/// @see write_delta
+///
+/// This is true for the user-defined class types serialized as records.
+/// Values of other types, including the standard library classes, are compared
+/// as a whole and written whole if they changed.
+template <typename T>
+struct is_delta_record : std::bool_constant<_reflects_delta_record<T>()> {};
+
+template <>
+struct is_delta_record<tribool> : std::false_type {};
+template <typename T>
+struct is_delta_record<bitfield<T>> : std::false_type {};
+
+template <typename T>
+constexpr const bool is_delta_record_v = is_delta_record<T>::value;
+//------------------------------------------------------------------------------
+template <typename T>
+constexpr auto _delta_members() noexcept {
+    return unpack(filter(get_data_members(mirror(T)), not_(is_static(_1))));
+}
+
+// the changes between two values, computed in a single pass before writing
+template <typename T, bool = is_delta_record_v<T>>
+struct _delta_changes {
+    bool differs{false};
+
+    // values that cannot be compared are always considered changed
+    void compute(const T& old_value, const T& new_value) noexcept {
+        if constexpr(std::equality_comparable<T>) {
+            differs = !(old_value == new_value);
+        } else {
+            differs = true;
+        }
+    }
+};
+
+template <__metaobject_id... M>
+auto _delta_member_changes(unpacked_metaobject_sequence<M...>)
+  -> std::tuple<_delta_changes<std::remove_cvref_t<__unrefltype(M)>>...>;
+
+template <typename T>
+struct _delta_changes<T, true> {
+    decltype(_delta_member_changes(_delta_members<T>())) members{};
+    size_t count{0Z};
+    bool differs{false};
+
+    void compute(const T& old_value, const T& new_value) noexcept {
+        _compute(
+          old_value,
+          new_value,
+          _delta_members<T>(),
+          std::make_index_sequence<get_size(_delta_members<T>())>{});
+        differs = count > 0Z;
+    }
+
+private:
+    template <__metaobject_id... M, size_t... I>
+    void _compute(
+      const T& old_value,
+      const T& new_value,
+      unpacked_metaobject_sequence<M...>,
+      std::index_sequence<I...>) noexcept {
+        ((std::get<I>(members).compute(
+            get_value(wrapped_metaobject<M>{}, old_value),
+            get_value(wrapped_metaobject<M>{}, new_value)),
+          count += std::get<I>(members).differs ? 1Z : 0Z),
+         ...);
+    }
+};
+//------------------------------------------------------------------------------
+/// @brief Writes the difference between two values of record type T.
+/// @ingroup serialization
+/// @see delta_deserializer
+///
+/// The delta is a list of the changed data members, each written as a pair
+/// of the index of the member in the sequence of non-static data members
+/// and of its new value, or recursively of the delta of its value if it is
+/// a record itself.
+template <typename T>
+struct delta_serializer {
+private:
+    template <typename>
+    friend struct delta_serializer;
+
+    template <write_backend Backend, typename M>
+    static auto _write_change(
+      const write_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      size_t index,
+      const M& old_value,
+      const M& new_value,
+      const _delta_changes<M>& changes) noexcept -> write_errors {
+        write_errors errors{};
+        auto subctx{backend.begin_list(ctx, 2Z)};
+        if(MIRROR_LIKELY(has_value(subctx))) {
+            auto idxctx{backend.begin_element(extract(subctx), 0Z)};
+            errors |= driver.write(backend, extract(idxctx), index);
+            errors |= backend.finish_element(extract(idxctx), 0Z);
+            errors |= backend.separate_element(extract(subctx));
+            auto valctx{backend.begin_element(extract(subctx), 1Z)};
+            if constexpr(is_delta_record_v<M>) {
+                errors |= delta_serializer<M>::_write_changes(
+                  driver,
+                  backend,
+                  extract(valctx),
+                  old_value,
+                  new_value,
+                  changes);
+            } else {
+                errors |= driver.write(backend, extract(valctx), new_value);
+            }
+            errors |= backend.finish_element(extract(valctx), 1Z);
+            errors |= backend.finish_list(extract(subctx));
+        } else {
+            errors |= std::get<write_errors>(subctx);
+        }
+        return errors;
+    }
+
+    template <write_backend Backend, __metaobject_id... M, size_t... I>
+    static auto _write_members(
+      const write_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      const T& old_value,
+      const T& new_value,
+      const _delta_changes<T>& changes,
+      unpacked_metaobject_sequence<M...>,
+      std::index_sequence<I...>) noexcept -> write_errors {
+        write_errors errors{};
+        size_t idx = 0;
+        const auto write_member = [&](size_t index, auto mdm, const auto& d) {
+            if(d.differs) {
+                if(idx > 0Z) {
+                    errors |= backend.separate_element(ctx);
+                }
+                auto subctx{backend.begin_element(ctx, idx)};
+                errors |= _write_change(
+                  driver,
+                  backend,
+                  extract(subctx),
+                  index,
+                  get_value(mdm, old_value),
+                  get_value(mdm, new_value),
+                  d);
+                errors |= backend.finish_element(extract(subctx), idx);
+                ++idx;
+            }
+        };
+        (write_member(
+           I, wrapped_metaobject<M>{}, std::get<I>(changes.members)),
+         ...);
+        return errors;
+    }
+
+    template <write_backend Backend>
+    static auto _write_changes(
+      const write_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      const T& old_value,
+      const T& new_value,
+      const _delta_changes<T>& changes) noexcept -> write_errors {
+        write_errors errors{};
+        auto subctx{backend.begin_list(ctx, changes.count)};
+        if(MIRROR_LIKELY(has_value(subctx))) {
+            errors |= _write_members(
+              driver,
+              backend,
+              extract(subctx),
+              old_value,
+              new_value,
+              changes,
+              _delta_members<T>(),
+              std::make_index_sequence<get_size(_delta_members<T>())>{});
+            errors |= backend.finish_list(extract(subctx));
+        } else {
+            errors |= std::get<write_errors>(subctx);
+        }
+        return errors;
+    }
+
+public:
+    template <write_backend Backend>
+    auto write(
+      const write_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      const T& old_value,
+      const T& new_value) const noexcept -> write_errors {
+        _delta_changes<T> changes;
+        changes.compute(old_value, new_value);
+        return _write_changes(
+          driver, backend, ctx, old_value, new_value, changes);
+    }
+};
+//------------------------------------------------------------------------------
+/// @brief Applies a delta written by delta_serializer to a value of type T.
+/// @ingroup serialization
+/// @see delta_serializer
+template <typename T>
+struct delta_deserializer {
+private:
+    template <read_backend Backend, __metaobject_id M>
+    static auto _apply_member(
+      const read_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      T& value) noexcept -> read_errors {
+        auto& member{get_reference(wrapped_metaobject<M>{}, value)};
+        using member_t = std::remove_cvref_t<decltype(member)>;
+        if constexpr(is_delta_record_v<member_t>) {
+            return delta_deserializer<member_t>{}.read(
+              driver, backend, ctx, member);
+        } else {
+            return driver.read(backend, ctx, member);
+        }
+    }
+
+    template <read_backend Backend, __metaobject_id... M>
+    static auto _apply_change(
+      const read_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      T& value,
+      unpacked_metaobject_sequence<M...>) noexcept -> read_errors {
+        using applier_t = read_errors (*)(
+          const read_driver&, Backend&, typename Backend::context_param, T&);
+        static constexpr std::array<applier_t, sizeof...(M)> appliers{
+          {&_apply_member<Backend, M>...}};
+
+        read_errors errors{};
+        size_t size{2Z};
+        const auto subctx{backend.begin_list(ctx, size)};
+        if(MIRROR_LIKELY(has_value(subctx))) {
+            if(MIRROR_UNLIKELY(size != 2Z)) {
+                return {read_error_code::invalid_format};
+            }
+            size_t index{0Z};
+            const auto idxctx{backend.begin_element(extract(subctx), 0Z)};
+            errors |= driver.read(backend, extract(idxctx), index);
+            errors |= backend.finish_element(extract(subctx), 0Z);
+            if(MIRROR_UNLIKELY(index >= sizeof...(M))) {
+                errors |= read_error_code::invalid_format;
+            }
+            if(MIRROR_UNLIKELY(errors)) {
+                return errors;
+            }
+            errors |= backend.separate_element(extract(subctx));
+            const auto valctx{backend.begin_element(extract(subctx), 1Z)};
+            errors |= appliers[index](driver, backend, extract(valctx), value);
+            errors |= backend.finish_element(extract(subctx), 1Z);
+            errors |= backend.finish_list(extract(subctx));
+        } else {
+            errors |= std::get<read_errors>(subctx);
+        }
+        return errors;
+    }
+
+public:
+    template <read_backend Backend>
+    auto read(
+      const read_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      T& value) const noexcept -> read_errors {
+        const auto mdms{
+          filter(get_data_members(mirror(T)), not_(is_static(_1)))};
+
+        read_errors errors{};
+        size_t count{0Z};
+        const auto subctx{backend.begin_list(ctx, count)};
+        if(MIRROR_LIKELY(has_value(subctx))) {
+            for(size_t idx = 0; idx < count && !errors; ++idx) {
+                if(idx > 0Z) {
+                    errors |= backend.separate_element(extract(subctx));
+                }
+                const auto subsubctx{
+                  backend.begin_element(extract(subctx), idx)};
+                errors |= _apply_change(
+                  driver, backend, extract(subsubctx), value, unpack(mdms));
+                errors |= backend.finish_element(extract(subctx), idx);
+            }
+            errors |= backend.finish_list(extract(subctx));
+        } else {
+            errors |= std::get<read_errors>(subctx);
+        }
+        return errors;
+    }
+};
+//------------------------------------------------------------------------------
+/// @brief Serializes the changes of a record between two snapshots.
+/// @ingroup serialization
+/// @see apply_delta
+///
+/// Only the data members whose values differ are written, so the size
+/// of the output and the work done are proportional to the amount of change.
+/// Members of user-defined records are compared and written recursively,
+/// members of other types, including the standard library classes, are
+/// compared with operator == if they have one and written whole if they
+/// differ. The changes are found in a single pass over both values.
+template <typename T, write_backend Backend>
+auto write_delta(
+  const T& old_value,
+  const T& new_value,
+  Backend& backend,
+  typename Backend::context_param ctx) noexcept -> write_errors {
+    write_errors errors{};
+    auto subctx{backend.begin(ctx)};
+    if(MIRROR_LIKELY(has_value(subctx))) {
+        write_driver driver;
+        errors |= delta_serializer<T>{}.write(
+          driver, backend, extract(subctx), old_value, new_value);
+        errors |= backend.finish(extract(subctx));
+    } else {
+        errors |= std::get<write_errors>(subctx);
+    }
+    return errors;
+}
+//------------------------------------------------------------------------------
+/// @brief Updates a record with the changes serialized by write_delta.
+/// @ingroup serialization
+/// @see write_delta
+///
+/// The value should be equal to the old value passed to write_delta,
+/// the members that are not in the delta are left untouched.
+template <typename T, read_backend Backend>
+auto apply_delta(
+  T& value,
+  Backend& backend,
+  typename Backend::context_param ctx) noexcept -> read_errors {
+    read_errors errors{};
+    auto subctx{backend.begin(ctx)};
+    if(MIRROR_LIKELY(has_value(subctx))) {
+        read_driver driver;
+        errors |= delta_deserializer<T>{}.read(
+          driver, backend, extract(subctx), value);
+        errors |= backend.finish(extract(subctx));
+    } else {
+        errors |= std::get<read_errors>(subctx);
+    }
+    return errors;
+}
+//------------------------------------------------------------------------------
+} // namespace mirror::serialize
+
+#endif // MIRROR_SERIALIZE_DELTA_HPP
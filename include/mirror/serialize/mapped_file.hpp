@@ -0,0 +1,231 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef MIRROR_SERIALIZE_MAPPED_FILE_HPP
+#define MIRROR_SERIALIZE_MAPPED_FILE_HPP
+
+#include "data_sink.hpp"
+#include "data_source.hpp"
+#include "read_binary.hpp"
+#include "size.hpp"
+#include "write_binary.hpp"
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <utility>
+
+// the memory mapping of files is implemented only for POSIX systems, on other
+// systems this header declares nothing and MIRROR_HAS_MAPPED_FILE is zero
+#if __has_include(<fcntl.h>) && __has_include(<sys/mman.h>) && \
+  __has_include(<sys/stat.h>) && __has_include(<unistd.h>)
+#define MIRROR_HAS_MAPPED_FILE 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define MIRROR_HAS_MAPPED_FILE 0
+#endif
+
+#if MIRROR_HAS_MAPPED_FILE
+namespace mirror::serialize {
+//------------------------------------------------------------------------------
+/// @brief Memory mapping of a whole file, used as serialization source or sink.
+/// @ingroup serialization
+/// @see write_binary_file
+///
+/// Data sources created by a mapping read straight from the mapped pages,
+/// so deserialized string views and byte spans point into the mapping and
+/// stay valid only as long as it exists. Data sinks write straight into
+/// the pages of a file created with a fixed size. Available only on POSIX
+/// systems, where MIRROR_HAS_MAPPED_FILE is defined as one.
+class mapped_file {
+public:
+    /// @brief Maps an existing file for reading.
+    static auto open(const char* path) noexcept -> std::optional<mapped_file> {
+        const int fd{::open(path, O_RDONLY | O_CLOEXEC)};
+        if(MIRROR_UNLIKELY(fd < 0)) {
+            return {};
+        }
+        struct ::stat st {};
+        std::optional<mapped_file> result;
+        if(MIRROR_LIKELY(::fstat(fd, &st) == 0 && st.st_size >= 0)) {
+            result = _map(fd, size_t(st.st_size), PROT_READ);
+        }
+        ::close(fd);
+        if(result && result->_size > 0Z) {
+            // the typical use is a single front-to-back pass
+            ::madvise(result->_addr, result->_size, MADV_SEQUENTIAL);
+        }
+        return result;
+    }
+
+    /// @brief Creates or truncates a file with the specified size and maps it.
+    /// The blocks of the file are allocated up front, so that writing into
+    /// the mapping cannot fail for lack of space. If that or the mapping
+    /// fails, the file is removed.
+    static auto create(const char* path, size_t size) noexcept
+      -> std::optional<mapped_file> {
+        const int fd{
+          ::open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)};
+        if(MIRROR_UNLIKELY(fd < 0)) {
+            return {};
+        }
+        std::optional<mapped_file> result;
+        if(size == 0Z || ::posix_fallocate(fd, 0, ::off_t(size)) == 0) {
+            result = _map(fd, size, PROT_READ | PROT_WRITE);
+        }
+        ::close(fd);
+        if(MIRROR_UNLIKELY(!result)) {
+            ::unlink(path);
+        }
+        return result;
+    }
+
+    mapped_file(mapped_file&& that) noexcept
+      : _addr{std::exchange(that._addr, nullptr)}
+      , _size{std::exchange(that._size, 0Z)}
+      , _writable{that._writable} {}
+
+    mapped_file(const mapped_file&) = delete;
+
+    auto operator=(mapped_file&& that) noexcept -> mapped_file& {
+        if(this != &that) {
+            _unmap();
+            _addr = std::exchange(that._addr, nullptr);
+            _size = std::exchange(that._size, 0Z);
+            _writable = that._writable;
+        }
+        return *this;
+    }
+
+    auto operator=(const mapped_file&) = delete;
+
+    ~mapped_file() noexcept {
+        _unmap();
+    }
+
+    /// @brief Returns the size of the mapped file in bytes.
+    auto size() const noexcept -> size_t {
+        return _size;
+    }
+
+    /// @brief Returns a view of the mapped bytes.
+    auto bytes() const noexcept -> std::span<const std::byte> {
+        return {static_cast<const std::byte*>(_addr), _size};
+    }
+
+    /// @brief Returns a mutable view of the mapped bytes.
+    /// Returns an empty span if the file was not mapped for writing.
+    auto writable_bytes() noexcept -> std::span<std::byte> {
+        if(!_writable) {
+            return {};
+        }
+        return {static_cast<std::byte*>(_addr), _size};
+    }
+
+    /// @brief Returns a data source reading from the mapped bytes.
+    auto source() const noexcept -> span_data_source {
+        return {bytes()};
+    }
+
+    /// @brief Returns a data sink writing into the mapped bytes.
+    auto sink() noexcept -> span_data_sink {
+        return {writable_bytes()};
+    }
+
+    /// @brief Schedules the write-back of modified pages to the file.
+    /// The errors of the write-back itself are not reported.
+    auto flush() noexcept -> bool {
+        return _size == 0Z || ::msync(_addr, _size, MS_ASYNC) == 0;
+    }
+
+    /// @brief Writes the modified pages back to the file and waits for it.
+    auto sync() noexcept -> bool {
+        return _size == 0Z || ::msync(_addr, _size, MS_SYNC) == 0;
+    }
+
+private:
+    mapped_file(void* addr, size_t size, bool writable) noexcept
+      : _addr{addr}
+      , _size{size}
+      , _writable{writable} {}
+
+    static auto _map(int fd, size_t size, int prot) noexcept
+      -> std::optional<mapped_file> {
+        // mapping an empty range fails, an empty file maps to nothing
+        if(size == 0Z) {
+            return {mapped_file{nullptr, 0Z, (prot & PROT_WRITE) != 0}};
+        }
+        void* addr{::mmap(nullptr, size, prot, MAP_SHARED, fd, 0)};
+        if(MIRROR_UNLIKELY(addr == MAP_FAILED)) {
+            return {};
+        }
+        return {mapped_file{addr, size, (prot & PROT_WRITE) != 0}};
+    }
+
+    void _unmap() noexcept {
+        if(_addr) {
+            ::munmap(_addr, _size);
+            _addr = nullptr;
+            _size = 0Z;
+        }
+    }
+
+    void* _addr{nullptr};
+    size_t _size{0Z};
+    bool _writable{false};
+};
+//------------------------------------------------------------------------------
+/// @brief Serializes a value in the compact binary format into a mapped file.
+/// @ingroup serialization
+/// @see read_binary_file
+/// @see serialized_size
+///
+/// The file is created with the exact size of the serialized value and
+/// the value is written straight into the mapped pages, which are synced
+/// to the file before returning. If anything fails, the file is removed.
+template <typename T>
+auto write_binary_file(const T& value, const char* path) noexcept
+  -> write_errors {
+    write_errors errors{};
+    const auto size{serialized_size(value, errors)};
+    if(MIRROR_UNLIKELY(errors)) {
+        return errors;
+    }
+    auto file{mapped_file::create(path, size)};
+    if(MIRROR_UNLIKELY(!file)) {
+        return {write_error_code::data_sink_error};
+    }
+    auto sink{file->sink()};
+    errors |= write_binary(value, sink);
+    if(MIRROR_UNLIKELY(!file->sync())) {
+        errors |= write_error_code::data_sink_error;
+    }
+    if(MIRROR_UNLIKELY(errors)) {
+        ::unlink(path);
+    }
+    return errors;
+}
+//------------------------------------------------------------------------------
+/// @brief Deserializes a value in the compact binary format from a mapped file.
+/// @ingroup serialization
+/// @see write_binary_file
+///
+/// String views and byte spans read into @p value point into the mapping,
+/// so @p file must outlive them.
+template <typename T>
+auto read_binary_file(T& value, const mapped_file& file) noexcept
+  -> read_errors {
+    return read_binary(value, file.bytes());
+}
+//------------------------------------------------------------------------------
+} // namespace mirror::serialize
+#endif // MIRROR_HAS_MAPPED_FILE
+
+#endif // MIRROR_SERIALIZE_MAPPED_FILE_HPP
@@ -0,0 +1,356 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef MIRROR_SERIALIZE_PARALLEL_READ_HPP
+#define MIRROR_SERIALIZE_PARALLEL_READ_HPP
+
+#include "record_stream.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace mirror::serialize {
+//------------------------------------------------------------------------------
+/// @brief Enumeration of the orders in which records read in parallel arrive.
+/// @ingroup serialization
+/// @see parallel_read_records
+enum class record_order : std::uint8_t {
+    /// @brief The records are delivered in the order of the input.
+    preserved,
+    /// @brief The records are delivered as soon as they are decoded.
+    arbitrary
+};
+//------------------------------------------------------------------------------
+// finds the frame starting at pos and moves pos past it
+inline auto _next_record_frame(
+  std::span<const std::byte> input,
+  size_t& pos,
+  std::span<const std::byte>& frame) noexcept -> read_errors {
+    std::uint64_t size{0U};
+    for(unsigned shift = 0U;; shift += 7U) {
+        if(MIRROR_UNLIKELY(pos >= input.size())) {
+            return {read_error_code::not_enough_data};
+        }
+        if(MIRROR_UNLIKELY(shift >= 64U)) {
+            return {read_error_code::invalid_format};
+        }
+        const auto byte{std::to_integer<std::uint64_t>(input[pos++])};
+        // the tenth byte holds only the highest bit of the size
+        if(MIRROR_UNLIKELY(shift == 63U && (byte & 0x7EU) != 0U)) {
+            return {read_error_code::invalid_format};
+        }
+        size |= (byte & 0x7FU) << shift;
+        if((byte & 0x80U) == 0U) {
+            break;
+        }
+    }
+    if(MIRROR_UNLIKELY(size > input.size() - pos)) {
+        return {read_error_code::not_enough_data};
+    }
+    frame = input.subspan(pos, size_t(size));
+    pos += size_t(size);
+    return {};
+}
+//------------------------------------------------------------------------------
+// the largest number of bytes in a chunk of records read in parallel, unless
+// a single record is larger, this bounds the memory of the preserved order
+constexpr const size_t _record_chunk_size{4Z * 1024Z * 1024Z};
+//------------------------------------------------------------------------------
+// splits the input into chunks of whole records of about target bytes
+inline auto _split_record_chunks(
+  std::span<const std::byte> input,
+  record_framing framing,
+  size_t target) -> std::vector<std::span<const std::byte>> {
+    std::vector<std::span<const std::byte>> result;
+    size_t begin{0Z};
+    while(begin < input.size()) {
+        size_t end{begin};
+        if(framing == record_framing::json_lines) {
+            end = std::min(begin + target, input.size());
+            while(end < input.size() && input[end - 1Z] != std::byte('\n')) {
+                ++end;
+            }
+        } else {
+            std::span<const std::byte> frame;
+            while(end - begin < target) {
+                if(_next_record_frame(input, end, frame)) {
+                    // the chunk reader reports the truncated frame
+                    end = input.size();
+                    break;
+                }
+                if(end >= input.size()) {
+                    break;
+                }
+            }
+        }
+        result.push_back(input.subspan(begin, end - begin));
+        begin = end;
+    }
+    return result;
+}
+//------------------------------------------------------------------------------
+// decodes the records from a chunk, acquire returns the object to decode
+// each of them into and commit is called after it is decoded
+template <typename T, typename Acquire, typename Commit>
+auto _read_record_chunk(
+  std::span<const std::byte> chunk,
+  record_framing framing,
+  std::string& text,
+  rapidjson_pull_read_backend& json_backend,
+  Acquire acquire,
+  Commit commit) -> read_errors {
+    read_errors errors{};
+    if(framing == record_framing::json_lines) {
+        // the lines are parsed in-situ and zero-terminated in place
+        text.assign(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+        char* line{text.data()};
+        char* const end{line + text.size()};
+        while(line < end) {
+            auto* eol{static_cast<char*>(
+              std::memchr(line, '\n', size_t(end - line)))};
+            if(!eol) {
+                eol = end;
+            }
+            *eol = '\0';
+            const std::string_view view{line, size_t(eol - line)};
+            if(view.find_first_not_of(" \t\r") != std::string_view::npos) {
+                T& value{acquire()};
+                const auto record_errors{read(value, json_backend, {line})};
+                commit(value, !record_errors);
+                errors |= record_errors;
+            }
+            line = eol + 1;
+        }
+    } else {
+        size_t pos{0Z};
+        while(pos < chunk.size()) {
+            std::span<const std::byte> frame;
+            if(const auto frame_errors{_next_record_frame(chunk, pos, frame)}) {
+                errors |= frame_errors;
+                break;
+            }
+            T& value{acquire()};
+            const auto record_errors{read_binary(value, frame)};
+            commit(value, !record_errors);
+            errors |= record_errors;
+        }
+    }
+    return errors;
+}
+//------------------------------------------------------------------------------
+/// @brief Decodes a large block of NDJSON or binary-framed records in parallel.
+/// @ingroup serialization
+/// @see record_stream_reader
+/// @see mapped_file
+///
+/// The input, typically a mapped file, is split at record boundaries into
+/// chunks of at most a few MiB, and into several chunks per thread if it is
+/// smaller. The threads take the next undecoded chunk as they become free,
+/// so that fast threads take over work from slow ones. Each thread has its
+/// own parser. The decoded records are passed to the consumer as non-const
+/// references to T. The JSON parser works in-situ, so each chunk of NDJSON
+/// is first copied into a buffer, binary frames are decoded straight from
+/// the input.
+///
+/// With record_order::arbitrary the consumer is called from the worker
+/// threads concurrently, as soon as each record is decoded, and it must be
+/// thread-safe. With record_order::preserved the records of each chunk are
+/// collected and the consumer is called from the calling thread in the input
+/// order. The number of chunks decoded ahead is bounded by twice the number
+/// of threads, so the memory used depends on the size of the chunks and
+/// not on the size of the input. In both cases string views read into the
+/// records are valid only during the call of the consumer, unless they
+/// point into binary input.
+///
+/// Records that fail to decode are skipped and their errors are combined
+/// into the result. An exception thrown by the consumer or while decoding
+/// stops the reading, the threads finish the chunks they are decoding and
+/// the first exception is then rethrown from the calling thread.
+template <typename T, typename Consumer>
+auto parallel_read_records(
+  std::span<const std::byte> input,
+  record_framing framing,
+  Consumer consumer,
+  record_order order = record_order::preserved,
+  unsigned thread_count = 0U) -> read_errors {
+    if(thread_count == 0U) {
+        thread_count = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    const auto chunks{_split_record_chunks(
+      input,
+      framing,
+      std::min(
+        _record_chunk_size, input.size() / (size_t(thread_count) * 8Z) + 1Z))};
+
+    std::mutex mutex;
+    read_errors errors{};
+    // exceptions must not escape the worker threads
+    std::exception_ptr failure;
+
+    if(order == record_order::arbitrary) {
+        std::atomic<size_t> next{0Z};
+        const auto fail = [&]() {
+            // the other threads stop after their current chunk
+            next = chunks.size();
+            const std::lock_guard lock{mutex};
+            if(!failure) {
+                failure = std::current_exception();
+            }
+        };
+        const auto work = [&]() {
+            try {
+                std::string text;
+                rapidjson_pull_read_backend json_backend;
+                T value{};
+                read_errors thread_errors{};
+                for(size_t i{next++}; i < chunks.size(); i = next++) {
+                    thread_errors |= _read_record_chunk<T>(
+                      chunks[i],
+                      framing,
+                      text,
+                      json_backend,
+                      [&]() -> T& { return value; },
+                      [&](T& decoded, bool ok) {
+                          if(ok) {
+                              consumer(decoded);
+                          }
+                      });
+                }
+                const std::lock_guard lock{mutex};
+                errors |= thread_errors;
+            } catch(...) {
+                fail();
+            }
+        };
+        std::vector<std::jthread> threads;
+        try {
+            threads.reserve(thread_count - 1U);
+            for(unsigned t = 1U; t < thread_count; ++t) {
+                threads.emplace_back(work);
+            }
+        } catch(...) {
+            fail();
+        }
+        // the calling thread takes part in the work
+        work();
+        threads.clear();
+    } else {
+        struct chunk_slot {
+            std::string text;
+            std::vector<T> values;
+            read_errors errors{};
+            bool done{false};
+        };
+        std::vector<chunk_slot> slots(chunks.size());
+        std::condition_variable changed;
+        const size_t window{size_t(thread_count) * 2Z};
+        size_t next{0Z};
+        size_t delivered{0Z};
+
+        const auto fail = [&]() {
+            {
+                // no more chunks are taken and the delivery stops
+                const std::lock_guard lock{mutex};
+                next = chunks.size();
+                if(!failure) {
+                    failure = std::current_exception();
+                }
+            }
+            changed.notify_all();
+        };
+        const auto work = [&]() {
+            try {
+                rapidjson_pull_read_backend json_backend;
+                while(true) {
+                    size_t i{0Z};
+                    {
+                        std::unique_lock lock{mutex};
+                        changed.wait(lock, [&]() {
+                            return next >= chunks.size() ||
+                                   next < delivered + window;
+                        });
+                        if(next >= chunks.size()) {
+                            return;
+                        }
+                        i = next++;
+                    }
+                    auto& slot{slots[i]};
+                    const auto chunk_errors{_read_record_chunk<T>(
+                      chunks[i],
+                      framing,
+                      slot.text,
+                      json_backend,
+                      [&]() -> T& { return slot.values.emplace_back(); },
+                      [&](T&, bool ok) {
+                          if(!ok) {
+                              slot.values.pop_back();
+                          }
+                      })};
+                    {
+                        const std::lock_guard lock{mutex};
+                        slot.errors = chunk_errors;
+                        slot.done = true;
+                    }
+                    changed.notify_all();
+                }
+            } catch(...) {
+                fail();
+            }
+        };
+        std::vector<std::jthread> threads;
+        try {
+            threads.reserve(thread_count);
+            for(unsigned t = 0U; t < thread_count; ++t) {
+                threads.emplace_back(work);
+            }
+            for(size_t i = 0Z; i < slots.size(); ++i) {
+                auto& slot{slots[i]};
+                {
+                    std::unique_lock lock{mutex};
+                    changed.wait(lock, [&]() { return slot.done || failure; });
+                    if(failure) {
+                        break;
+                    }
+                }
+                for(T& value : slot.values) {
+                    consumer(value);
+                }
+                errors |= slot.errors;
+                // release the memory of the delivered chunk
+                slot.values = {};
+                slot.text = {};
+                {
+                    const std::lock_guard lock{mutex};
+                    delivered = i + 1Z;
+                }
+                changed.notify_all();
+            }
+        } catch(...) {
+            fail();
+        }
+        threads.clear();
+    }
+    if(failure) {
+        std::rethrow_exception(failure);
+    }
+    return errors;
+}
+//------------------------------------------------------------------------------
+} // namespace mirror::serialize
+
+#endif // MIRROR_SERIALIZE_PARALLEL_READ_HPP
@@ -10,14 +10,18 @@
 #define MIRROR_SERIALIZE_READ_HPP
 
 #include "../branch_predict.hpp"
+#include "../enum_utils.hpp"
+#include "../name_index.hpp"
 #include "../placeholder.hpp"
 #include "../sequence.hpp"
 #include "../tribool.hpp"
 #include "read_backend.hpp"
 #include <array>
+#include <bitset>
 #include <chrono>
 #include <optional>
 #include <span>
+#include <string>
 #include <tuple>
 #include <type_traits>
 #include <variant>
@@ -38,6 +42,70 @@ struct read_driver {
     }
 };
 //------------------------------------------------------------------------------
+/// @brief Indicates if T is a std::basic_string of char with any allocator.
+/// @ingroup serialization
+template <typename T>
+struct is_char_string : std::false_type {};
+
+template <typename A>
+struct is_char_string<std::basic_string<char, std::char_traits<char>, A>>
+  : std::true_type {};
+
+template <typename T>
+constexpr const bool is_char_string_v = is_char_string<T>::value;
+//------------------------------------------------------------------------------
+/// @brief Indicates if reading T stores string views or byte spans in it.
+/// @ingroup serialization
+///
+/// Such values point into the input, which must outlive them, so they cannot
+/// be read by the functions that parse a temporary copy of the input.
+template <typename T>
+struct holds_input_views {
+private:
+    template <__metaobject_id... M>
+    static consteval auto _any(unpacked_metaobject_sequence<M...>) -> bool {
+        return (
+          false || ... ||
+          holds_input_views<std::remove_cvref_t<__unrefltype(M)>>::value);
+    }
+
+    static consteval auto _get() -> bool {
+        if constexpr(std::is_class_v<T>) {
+            if constexpr(reflects_record(mirror(T))) {
+                return _any(
+                  filter(get_data_members(mirror(T)), not_(is_static(_1))));
+            } else {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+
+public:
+    static constexpr const bool value{_get()};
+};
+
+template <>
+struct holds_input_views<std::string_view> : std::true_type {};
+template <>
+struct holds_input_views<std::span<const std::byte>> : std::true_type {};
+template <typename T>
+struct holds_input_views<std::optional<T>> : holds_input_views<T> {};
+template <typename T, size_t N>
+struct holds_input_views<std::span<T, N>>
+  : holds_input_views<std::remove_cv_t<T>> {};
+template <typename T, size_t N>
+struct holds_input_views<std::array<T, N>> : holds_input_views<T> {};
+template <typename T, typename A>
+struct holds_input_views<std::vector<T, A>> : holds_input_views<T> {};
+template <typename... T>
+struct holds_input_views<std::tuple<T...>>
+  : std::bool_constant<(false || ... || holds_input_views<T>::value)> {};
+
+template <typename T>
+constexpr const bool holds_input_views_v = holds_input_views<T>::value;
+//------------------------------------------------------------------------------
 template <typename T>
 struct deserializer<T&> : deserializer<T> {};
 //------------------------------------------------------------------------------
@@ -84,14 +152,40 @@ template <>
 struct deserializer<float> : plain_deserializer<float> {};
 template <>
 struct deserializer<double> : plain_deserializer<double> {};
+template <typename A>
+struct deserializer<std::basic_string<char, std::char_traits<char>, A>>
+  : plain_deserializer<std::basic_string<char, std::char_traits<char>, A>> {};
+/// @brief Reads a view of the string in the input without copying it.
+/// @note The input must outlive the value and may not be supported by all
+/// backends.
+template <>
+struct deserializer<std::string_view> : plain_deserializer<std::string_view> {};
+/// @brief Reads a view of a block of raw bytes in the input without copying it.
+/// @note The input must outlive the value and may not be supported by all
+/// backends.
 template <>
-struct deserializer<std::string> : plain_deserializer<std::string> {};
+struct deserializer<std::span<const std::byte>>
+  : plain_deserializer<std::span<const std::byte>> {};
 template <typename R, typename P>
 struct deserializer<std::chrono::duration<R, P>>
   : plain_deserializer<std::chrono::duration<R, P>> {};
 //------------------------------------------------------------------------------
 template <typename T>
 struct deserializer<bitfield<T>> {
+private:
+    // the backends that do not choose get the list of the set bits
+    template <read_backend Backend>
+    static auto _as_list(
+      Backend& backend,
+      typename Backend::context_param ctx) noexcept -> bool {
+        if constexpr(requires { backend.bitfield_as_list(ctx); }) {
+            return backend.bitfield_as_list(ctx);
+        } else {
+            return true;
+        }
+    }
+
+public:
     template <read_backend Backend>
     auto read(
       const read_driver& driver,
@@ -99,10 +193,25 @@ struct deserializer<bitfield<T>> {
       typename Backend::context_param ctx,
       bitfield<T>& value) const noexcept {
 
+        if(!_as_list(backend, ctx)) {
+            using value_type = typename bitfield<T>::value_type;
+            value_type bits{0U};
+            read_errors errors{driver.read(backend, ctx, bits)};
+            constexpr const value_type unknown{
+              value_type(~enum_lookup<T>::value_mask())};
+            if(MIRROR_UNLIKELY(value_type(bits & unknown) != value_type(0))) {
+                errors |= read_error_code::invalid_format;
+            } else {
+                value = bitfield<T>{bits};
+            }
+            return errors;
+        }
+
         read_errors errors{};
         size_t size{0Z};
         const auto subctx{backend.begin_list(ctx, size)};
         if(MIRROR_LIKELY(has_value(subctx))) {
+            value.clear();
             for(size_t idx{0Z}; idx < size; ++idx) {
                 T temp{};
                 const auto subsubctx{
@@ -133,11 +242,12 @@ struct deserializer<std::optional<T>> {
         const auto subctx{backend.begin_list(ctx, size)};
         if(MIRROR_LIKELY(has_value(subctx))) {
             if(size > 0Z) {
-                T temp{};
+                if(!value) {
+                    value.emplace();
+                }
                 const auto subsubctx{
                   backend.begin_element(extract(subctx), 0Z)};
-                errors |= driver.read(backend, extract(subsubctx), temp);
-                value = temp;
+                errors |= driver.read(backend, extract(subsubctx), *value);
                 errors |= backend.finish_element(extract(subctx), 0Z);
             } else {
                 value.reset();
@@ -150,6 +260,32 @@ struct deserializer<std::optional<T>> {
     }
 };
 //------------------------------------------------------------------------------
+template <read_backend Backend, typename T>
+auto _read_elements(
+  const read_driver& driver,
+  Backend& backend,
+  typename Backend::context_param ctx,
+  std::span<T> value) noexcept -> read_errors {
+    read_errors errors{};
+    size_t idx{0Z};
+    if constexpr(resumable_read_backend<Backend>) {
+        idx = backend.resume_index(ctx);
+    }
+    for(; idx < value.size(); ++idx) {
+        if(idx > 0Z) {
+            errors |= backend.separate_element(ctx);
+        }
+        const auto subctx{backend.begin_element(ctx, idx)};
+        errors |= driver.read(backend, extract(subctx), value[idx]);
+        errors |= backend.finish_element(ctx, idx);
+        // the rest is read when the read is resumed
+        if(MIRROR_UNLIKELY(errors.has(read_error_code::incomplete_read))) {
+            break;
+        }
+    }
+    return errors;
+}
+//------------------------------------------------------------------------------
 template <typename T, size_t N>
 struct deserializer<std::span<T, N>> {
     template <read_backend Backend>
@@ -167,19 +303,12 @@ struct deserializer<std::span<T, N>> {
         } else if(size < value.size()) {
             errors |= read_error_code::missing_element;
         } else if(MIRROR_LIKELY(has_value(subctx))) {
-            size_t idx = 0;
-            bool first = true;
-            for(auto& elem : value) {
-                if(first) {
-                    first = false;
-                } else {
-                    errors |= backend.separate_element(extract(subctx));
-                }
-                const auto subsubctx{
-                  backend.begin_element(extract(subctx), idx)};
-                errors |= driver.read(backend, extract(subsubctx), elem);
-                errors |= backend.finish_element(extract(subctx), idx);
-                ++idx;
+            if constexpr(bulk_read_backend<Backend, T>) {
+                errors |=
+                  backend.read_elements(extract(subctx), std::span<T>(value));
+            } else {
+                errors |= _read_elements(
+                  driver, backend, extract(subctx), std::span<T>(value));
             }
             errors |= backend.finish_list(extract(subctx));
         } else {
@@ -198,6 +327,7 @@ private:
       const Backend&,
       const Ctx&,
       const Tup&,
+      size_t,
       std::index_sequence<>) const noexcept {
         return read_errors{};
     }
@@ -213,17 +343,23 @@ private:
       Backend& backend,
       Ctx& ctx,
       Tup& value,
+      size_t first,
       std::index_sequence<I, Is...>) const {
         read_errors errors{};
-        auto subctx{backend.begin_element(extract(ctx), I)};
-        if(I > 0Z) {
-            errors |= backend.separate_element(extract(ctx));
+        if(I >= first) {
+            auto subctx{backend.begin_element(extract(ctx), I)};
+            if(I > 0Z) {
+                errors |= backend.separate_element(extract(ctx));
+            }
+            errors |= driver.read(backend, extract(subctx), std::get<I>(value));
+            errors |= backend.finish_element(extract(subctx), I);
+            if(MIRROR_UNLIKELY(errors.has(read_error_code::incomplete_read))) {
+                return errors;
+            }
         }
-        errors |= driver.read(backend, extract(subctx), std::get<I>(value));
-        errors |= backend.finish_element(extract(subctx), I);
 
-        errors |=
-          _do_read(driver, backend, ctx, value, std::index_sequence<Is...>{});
+        errors |= _do_read(
+          driver, backend, ctx, value, first, std::index_sequence<Is...>{});
 
         return errors;
     }
@@ -239,11 +375,16 @@ public:
         size_t size = sizeof...(T);
         auto subctx{backend.begin_list(ctx, size)};
         if(MIRROR_LIKELY(has_value(subctx))) {
-            _do_read(
+            size_t first{0Z};
+            if constexpr(resumable_read_backend<Backend>) {
+                first = backend.resume_index(extract(subctx));
+            }
+            errors |= _do_read(
               driver,
               backend,
               subctx,
               value,
+              first,
               std::make_index_sequence<sizeof...(T)>{});
             errors |= backend.finish_list(extract(subctx));
         } else {
@@ -278,21 +419,15 @@ struct deserializer<std::vector<T, A>> {
         read_errors errors{};
         size_t size{0Z};
         const auto subctx{backend.begin_list(ctx, size)};
-        value.resize(size);
         if(MIRROR_LIKELY(has_value(subctx))) {
-            size_t idx = 0;
-            bool first = true;
-            for(auto& elem : value) {
-                if(first) {
-                    first = false;
-                } else {
-                    errors |= backend.separate_element(extract(subctx));
-                }
-                const auto subsubctx{
-                  backend.begin_element(extract(subctx), idx)};
-                errors |= driver.read(backend, extract(subsubctx), elem);
-                errors |= backend.finish_element(extract(subctx), idx);
-                ++idx;
+            // the elements that are kept are read into, reusing their storage
+            value.resize(size);
+            if constexpr(bulk_read_backend<Backend, T>) {
+                errors |=
+                  backend.read_elements(extract(subctx), std::span<T>(value));
+            } else {
+                errors |= _read_elements(
+                  driver, backend, extract(subctx), std::span<T>(value));
             }
             errors |= backend.finish_list(extract(subctx));
         } else {
@@ -305,43 +440,54 @@ struct deserializer<std::vector<T, A>> {
 template <typename T>
 struct deserializer {
 private:
-    template <read_backend Backend>
-    auto _do_read(
+    template <read_backend Backend, __metaobject_id M>
+    static auto _read_member(
+      const read_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      T& value) noexcept -> read_errors {
+        return driver.read(
+          backend, ctx, get_reference(wrapped_metaobject<M>{}, value));
+    }
+
+    template <attribute_iterating_read_backend Backend, __metaobject_id... M>
+    auto _do_read_attributes(
       const read_driver& driver,
       Backend& backend,
       typename Backend::context_param ctx,
       T& value,
-      metaobject auto mt) const noexcept -> read_errors
-      requires(reflects_record(mt)) {
+      unpacked_metaobject_sequence<M...>) const noexcept -> read_errors {
+        using reader_t = read_errors (*)(
+          const read_driver&, Backend&, typename Backend::context_param, T&);
+        static constexpr name_index<sizeof...(M)> index{
+          {{get_name(wrapped_metaobject<M>{})...}}};
+        static constexpr std::array<reader_t, sizeof...(M)> readers{
+          {&_read_member<Backend, M>...}};
+
         read_errors errors{};
-        const auto mdms{filter(get_data_members(mt), not_(is_static(_1)))};
-        size_t count{get_size(mdms)};
+        size_t count{sizeof...(M)};
         auto subctx{backend.begin_record(ctx, count)};
-
-        if(count > get_size(mdms)) {
-            errors |= read_error_code::excess_member;
-        } else if(count < get_size(mdms)) {
-            errors |= read_error_code::missing_member;
-        }
-        if(has_value(subctx)) {
-            bool first = true;
-            for_each(mdms, [&](auto mdm) {
-                if(first) {
-                    first = false;
-                } else {
-                    errors |= backend.separate_attribute(extract(subctx));
+        if(MIRROR_LIKELY(has_value(subctx))) {
+            std::bitset<sizeof...(M)> found{};
+            while(backend.has_next_attribute(extract(subctx))) {
+                std::string_view name;
+                auto subsubctx{backend.next_attribute(extract(subctx), name)};
+                if(MIRROR_UNLIKELY(!has_value(subsubctx))) {
+                    errors |= std::get<read_errors>(subsubctx);
+                    break;
                 }
-                const auto name{get_name(mdm)};
-                auto subsubctx{backend.begin_attribute(extract(subctx), name)};
-                if(has_value(subsubctx)) {
-                    errors |= driver.read(
-                      backend, extract(subsubctx), get_reference(mdm, value));
+                if(const auto pos{index.find(name)}) {
                     errors |=
-                      backend.finish_attribute(extract(subsubctx), name);
+                      readers[*pos](driver, backend, extract(subsubctx), value);
+                    found.set(*pos);
                 } else {
-                    errors |= std::get<read_errors>(subsubctx);
+                    errors |= read_error_code::excess_member;
                 }
-            });
+                errors |= backend.finish_attribute(extract(subsubctx), name);
+            }
+            if(!found.all()) {
+                errors |= read_error_code::missing_member;
+            }
             errors |= backend.finish_record(extract(subctx));
         } else {
             errors |= std::get<read_errors>(subctx);
@@ -349,6 +495,65 @@ private:
         return errors;
     }
 
+    template <read_backend Backend>
+    auto _do_read(
+      const read_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      T& value,
+      metaobject auto mt) const noexcept -> read_errors
+      requires(reflects_record(mt)) {
+        const auto mdms{filter(get_data_members(mt), not_(is_static(_1)))};
+        if constexpr(attribute_iterating_read_backend<Backend>) {
+            return _do_read_attributes(driver, backend, ctx, value, mdms);
+        } else {
+            read_errors errors{};
+            size_t count{get_size(mdms)};
+            auto subctx{backend.begin_record(ctx, count)};
+
+            if(count > get_size(mdms)) {
+                errors |= read_error_code::excess_member;
+            } else if(count < get_size(mdms)) {
+                errors |= read_error_code::missing_member;
+            }
+            if(has_value(subctx)) {
+                size_t first{0Z};
+                if constexpr(resumable_read_backend<Backend>) {
+                    first = backend.resume_index(extract(subctx));
+                }
+                size_t idx{0Z};
+                for_each(mdms, [&](auto mdm) {
+                    // skips the members read before or after an incomplete one
+                    if(
+                      idx++ < first ||
+                      errors.has(read_error_code::incomplete_read)) {
+                        return;
+                    }
+                    if(idx > 1Z) {
+                        errors |= backend.separate_attribute(extract(subctx));
+                    }
+                    const auto name{get_name(mdm)};
+                    auto subsubctx{
+                      backend.begin_attribute(extract(subctx), name)};
+                    if(has_value(subsubctx)) {
+                        errors |= driver.read(
+                          backend,
+                          extract(subsubctx),
+                          get_reference(mdm, value));
+                        errors |=
+                          backend.finish_attribute(extract(subsubctx), name);
+                    } else {
+                        errors |= std::get<read_errors>(subsubctx);
+                    }
+                });
+                errors |= backend.finish_record(extract(subctx));
+            } else {
+                errors |= std::get<read_errors>(subctx);
+            }
+            return errors;
+        }
+    }
+
     template <read_backend Backend>
     auto _do_read(
       const read_driver& driver,
@@ -358,15 +563,14 @@ private:
       metaobject auto mt) const noexcept -> read_errors
       requires(reflects_enum(mt)) {
         read_errors errors{};
-        const auto mes{get_enumerators(mt)};
         if(backend.enum_as_string(ctx)) {
-            std::string name;
+            std::string_view name;
             errors |= driver.read(backend, ctx, name);
-            for_each(mes, [&](auto me) {
-                if(get_name(me) == name) {
-                    value = get_constant(me);
-                }
-            });
+            if(const auto found{enum_lookup<T>::value_of(name)}) {
+                value = *found;
+            } else if(!errors) {
+                errors |= read_error_code::invalid_format;
+            }
         } else {
             std::underlying_type_t<T> temp{};
             errors |= driver.read(backend, ctx, temp);
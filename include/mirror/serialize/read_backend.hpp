@@ -12,6 +12,9 @@
 #include "../extract.hpp"
 #include "result.hpp"
 #include <concepts>
+#include <cstdint>
+#include <span>
+#include <type_traits>
 
 namespace mirror::serialize {
 struct read_driver;
@@ -86,6 +89,84 @@ concept read_backend = requires(T v) {
     ->std::same_as<read_errors>;
 };
 
+/// @brief Concept for read backends reading contiguous ranges in one call.
+/// @ingroup serialization
+/// Such backends read all the elements of a list of arithmetic values of
+/// type E at once, between begin_list and finish_list, instead of having
+/// the deserializer read them one by one.
+template <typename T, typename E>
+concept bulk_read_backend = read_backend<T> && std::is_arithmetic_v<E> &&
+  requires(T v) {
+    {
+        v.read_elements(
+          std::declval<typename T::context&>(), std::declval<std::span<E>>())
+    }
+    ->std::same_as<read_errors>;
+};
+
+/// @brief Concept for read backends able to enumerate record attributes.
+/// @ingroup serialization
+/// Such backends let the deserializer visit the attributes of a record in the
+/// order in which they appear in the input, instead of looking each of them
+/// up by name.
+template <typename T>
+concept attribute_iterating_read_backend = read_backend<T> && requires(T v) {
+    { v.has_next_attribute(std::declval<typename T::context&>()) }
+    ->std::convertible_to<bool>;
+
+    {
+        v.next_attribute(
+          std::declval<typename T::context&>(),
+          std::declval<std::string_view&>())
+    }
+    ->extractable;
+};
+
+/// @brief Concept for read backends reading records with framed attributes.
+/// @ingroup serialization
+/// @see framed_write_backend
+/// Such backends read the name and the size of each attribute of a versioned
+/// record before its value, and can skip the values of unknown attributes
+/// without decoding them. If they also have a frame_position member function
+/// returning the number of bytes read so far, the deserializer checks that
+/// each attribute value takes exactly the size in its frame header.
+template <typename T>
+concept framed_read_backend = read_backend<T> && requires(T v) {
+    {
+        v.begin_framed_record(
+          std::declval<typename T::context&>(),
+          std::declval<std::uint64_t&>(),
+          std::declval<size_t&>())
+    }
+    ->extractable;
+
+    {
+        v.read_frame_header(
+          std::declval<typename T::context&>(),
+          std::declval<std::string_view&>(),
+          std::declval<size_t&>())
+    }
+    ->std::same_as<read_errors>;
+
+    {
+        v.skip_frame(
+          std::declval<typename T::context&>(), std::declval<size_t>())
+    }
+    ->std::same_as<read_errors>;
+};
+
+/// @brief Concept for read backends able to resume an interrupted read.
+/// @ingroup serialization
+/// @see resume_tracker
+/// Deserializers of lists and records call resume_index right after beginning
+/// them and continue with the element at the returned index, the elements
+/// before it were already read by a previous attempt and must be kept.
+template <typename T>
+concept resumable_read_backend = read_backend<T> && requires(T v) {
+    { v.resume_index(std::declval<typename T::context&>()) }
+    ->std::convertible_to<size_t>;
+};
+
 }; // namespace mirror::serialize
 
 #endif
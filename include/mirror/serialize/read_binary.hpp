@@ -0,0 +1,506 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef MIRROR_SERIALIZE_READ_BINARY_HPP
+#define MIRROR_SERIALIZE_READ_BINARY_HPP
+
+#include "../tribool.hpp"
+#include "data_source.hpp"
+#include "read.hpp"
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace mirror::serialize {
+//------------------------------------------------------------------------------
+/// @brief Deserialization backend reading the compact binary representation.
+/// @ingroup serialization
+/// @see basic_binary_write_backend
+template <data_source Source>
+struct basic_binary_read_backend {
+    struct context {
+        Source& source;
+    };
+    using context_param = context;
+
+    auto enum_as_string(context_param) noexcept -> bool {
+        return false;
+    }
+
+    auto bitfield_as_list(context_param) noexcept -> bool {
+        return false;
+    }
+
+    auto begin(context_param ctx) -> std::variant<context, read_errors> {
+        return {ctx};
+    }
+
+    template <typename R, typename P>
+    auto read(
+      const read_driver&,
+      context_param ctx,
+      std::chrono::duration<R, P>& value) -> read_errors {
+        R temp{};
+        const auto errors{_read_scalar(ctx, temp)};
+        value = std::chrono::duration<R, P>{temp};
+        return errors;
+    }
+
+    template <typename T>
+    auto read(const read_driver& drv, context_param ctx, T& value)
+      -> read_errors {
+        if constexpr(std::is_arithmetic_v<T> || std::is_same_v<T, tribool>) {
+            return _read_scalar(ctx, value);
+        } else if constexpr(is_char_string_v<T>) {
+            std::span<const std::byte> bytes;
+            const auto errors{_read_bytes(ctx, bytes)};
+            if(MIRROR_LIKELY(!errors)) {
+                value.assign(
+                  reinterpret_cast<const char*>(bytes.data()), bytes.size());
+            }
+            return errors;
+        } else if constexpr(std::is_same_v<T, std::string_view>) {
+            std::span<const std::byte> bytes;
+            const auto errors{_read_bytes(ctx, bytes)};
+            if(MIRROR_LIKELY(!errors)) {
+                value = {
+                  reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+            }
+            return errors;
+        } else if constexpr(std::is_same_v<T, std::span<const std::byte>>) {
+            return _read_bytes(ctx, value);
+        } else {
+            return drv.read(*this, ctx, value);
+        }
+    }
+
+    auto begin_list(context_param ctx, size_t& count)
+      -> std::variant<context, read_errors> {
+        const auto start{_position(ctx)};
+        if constexpr(tracking_data_source<Source>) {
+            // the list was begun by the previous attempt
+            if(const auto resumed{ctx.source.tracker().resumed_count()}) {
+                count = *resumed;
+                return _enter_level(ctx, count, start);
+            }
+        }
+        read_errors errors{_read_varint(ctx, count)};
+        if(MIRROR_LIKELY(!errors)) {
+            errors |= _check_count(ctx, count);
+        }
+        if(MIRROR_UNLIKELY(errors)) {
+            return errors;
+        }
+        return _enter_level(ctx, count, start);
+    }
+
+    template <typename T>
+    auto read_elements(context_param ctx, std::span<T> values) -> read_errors
+      requires(
+        std::is_integral_v<T> || std::is_same_v<T, float> ||
+        std::is_same_v<T, double>) {
+        if constexpr(
+          std::endian::native == std::endian::little &&
+          !std::is_same_v<T, bool>) {
+            const auto bytes{ctx.source.fetch(values.size_bytes())};
+            if(MIRROR_UNLIKELY(bytes.size() != values.size_bytes())) {
+                return _not_enough_data(ctx);
+            }
+            if(MIRROR_LIKELY(!bytes.empty())) {
+                std::memcpy(values.data(), bytes.data(), bytes.size());
+            }
+            return {};
+        } else {
+            read_errors errors{};
+            for(T& value : values) {
+                errors |= _read_scalar(ctx, value);
+            }
+            return errors;
+        }
+    }
+
+    auto begin_element(context_param ctx, size_t)
+      -> std::variant<context, read_errors> {
+        _enter_element(ctx);
+        return {ctx};
+    }
+
+    auto separate_element(context_param) -> read_errors {
+        return {};
+    }
+
+    auto finish_element(context_param, size_t) -> read_errors {
+        return {};
+    }
+
+    auto finish_list(context_param ctx) -> read_errors {
+        _leave_level(ctx);
+        return {};
+    }
+
+    auto begin_record(context_param ctx, size_t& count)
+      -> std::variant<context, read_errors> {
+        return _enter_level(ctx, count, _position(ctx));
+    }
+
+    auto begin_attribute(context_param ctx, std::string_view)
+      -> std::variant<context, read_errors> {
+        _enter_element(ctx);
+        return {ctx};
+    }
+
+    auto separate_attribute(context_param) -> read_errors {
+        return {};
+    }
+
+    auto finish_attribute(context_param, std::string_view) -> read_errors {
+        return {};
+    }
+
+    auto finish_record(context_param ctx) -> read_errors {
+        _leave_level(ctx);
+        return {};
+    }
+
+    auto begin_framed_record(
+      context_param ctx,
+      std::uint64_t& layout,
+      size_t& count) -> std::variant<context, read_errors> {
+        const auto errors{_read_fixed(ctx, layout)};
+        if(MIRROR_UNLIKELY(errors)) {
+            return errors;
+        }
+        return begin_list(ctx, count);
+    }
+
+    auto read_frame_header(
+      context_param ctx,
+      std::string_view& name,
+      size_t& size) -> read_errors {
+        _enter_element(ctx);
+        std::span<const std::byte> bytes;
+        read_errors errors{_read_bytes(ctx, bytes)};
+        if(MIRROR_LIKELY(!errors)) {
+            name = {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+            errors |= _read_varint(ctx, size);
+        }
+        return errors;
+    }
+
+    auto skip_frame(context_param ctx, size_t size) -> read_errors {
+        if(MIRROR_UNLIKELY(ctx.source.fetch(size).size() != size)) {
+            return _not_enough_data(ctx);
+        }
+        return {};
+    }
+
+    auto frame_position(context_param ctx) const noexcept -> size_t
+      requires(requires(const Source& s) { s.position(); }) {
+        return ctx.source.position();
+    }
+
+    auto resume_index(context_param ctx) noexcept -> size_t
+      requires(tracking_data_source<Source>) {
+        return ctx.source.tracker().resume_index();
+    }
+
+    auto finish(context_param) -> read_errors {
+        return {};
+    }
+
+private:
+    static auto _not_enough_data(context_param ctx) noexcept -> read_errors {
+        if constexpr(resumable_data_source<Source>) {
+            if(ctx.source.is_dry()) {
+                // the rest of the input is misaligned until the retry
+                ctx.source.stall();
+                return {read_error_code::incomplete_read};
+            }
+        }
+        return {read_error_code::not_enough_data};
+    }
+
+    // the structure of the values is followed only by sources that need it
+    static auto _position(context_param ctx) noexcept -> size_t {
+        if constexpr(tracking_data_source<Source>) {
+            return ctx.source.stream_position();
+        } else {
+            return 0Z;
+        }
+    }
+
+    static auto _enter_level(context_param ctx, size_t count, size_t start)
+      noexcept -> std::variant<context, read_errors> {
+        if constexpr(tracking_data_source<Source>) {
+            auto& tracker{ctx.source.tracker()};
+            if(MIRROR_UNLIKELY(!tracker.enter_level(count, start))) {
+                return read_errors{read_error_code::data_source_error};
+            }
+        }
+        return {ctx};
+    }
+
+    static void _enter_element(context_param ctx) noexcept {
+        if constexpr(tracking_data_source<Source>) {
+            ctx.source.tracker().enter_element(_position(ctx));
+        }
+    }
+
+    static void _leave_level(context_param ctx) noexcept {
+        if constexpr(tracking_data_source<Source>) {
+            ctx.source.tracker().leave_level();
+        }
+    }
+
+    // rejects counts and sizes that cannot fit into the rest of the input
+    // before the caller uses them to allocate memory, each element or byte
+    // takes at least one byte
+    static auto _check_count(context_param ctx, size_t count) noexcept
+      -> read_errors {
+        if constexpr(requires { ctx.source.remaining(); }) {
+            if(MIRROR_UNLIKELY(count > ctx.source.remaining())) {
+                return _not_enough_data(ctx);
+            }
+        }
+        return {};
+    }
+
+    // reads a size-prefixed block of bytes, the result views the source memory
+    static auto _read_bytes(
+      context_param ctx,
+      std::span<const std::byte>& value) noexcept -> read_errors {
+        size_t size{0Z};
+        read_errors errors{_read_varint(ctx, size)};
+        if(MIRROR_LIKELY(!errors)) {
+            errors |= _check_count(ctx, size);
+        }
+        if(MIRROR_LIKELY(!errors)) {
+            const auto bytes{ctx.source.fetch(size)};
+            if(MIRROR_LIKELY(bytes.size() == size)) {
+                value = bytes;
+            } else {
+                errors |= _not_enough_data(ctx);
+            }
+        }
+        return errors;
+    }
+
+    template <typename U>
+    static auto _read_fixed(context_param ctx, U& value) noexcept
+      -> read_errors {
+        static_assert(std::is_unsigned_v<U>);
+        const auto bytes{ctx.source.fetch(sizeof(U))};
+        if(MIRROR_UNLIKELY(bytes.size() != sizeof(U))) {
+            return _not_enough_data(ctx);
+        }
+        U temp{0U};
+        for(size_t i = 0Z; i < sizeof(U); ++i) {
+            temp |= U(U(bytes[i]) << (8U * i));
+        }
+        value = temp;
+        return {};
+    }
+
+    template <typename T>
+    static auto _read_scalar(context_param ctx, T& value) noexcept
+      -> read_errors {
+        read_errors errors{};
+        if constexpr(std::is_same_v<T, bool>) {
+            std::uint8_t temp{};
+            errors |= _read_fixed(ctx, temp);
+            if(MIRROR_UNLIKELY(temp > 1U)) {
+                errors |= read_error_code::invalid_format;
+            }
+            value = temp != 0U;
+        } else if constexpr(std::is_same_v<T, tribool>) {
+            std::uint8_t temp{};
+            errors |= _read_fixed(ctx, temp);
+            if(MIRROR_UNLIKELY(temp > 2U)) {
+                errors |= read_error_code::invalid_format;
+            }
+            value = tribool{temp == 1U, temp == 2U};
+        } else if constexpr(std::is_integral_v<T>) {
+            std::make_unsigned_t<T> temp{};
+            errors |= _read_fixed(ctx, temp);
+            value = T(temp);
+        } else if constexpr(std::is_same_v<T, float>) {
+            std::uint32_t temp{};
+            errors |= _read_fixed(ctx, temp);
+            value = std::bit_cast<float>(temp);
+        } else if constexpr(std::is_same_v<T, double>) {
+            std::uint64_t temp{};
+            errors |= _read_fixed(ctx, temp);
+            value = std::bit_cast<double>(temp);
+        } else {
+            errors |= read_error_code::not_supported;
+        }
+        return errors;
+    }
+
+    static auto _read_varint(context_param ctx, size_t& value) noexcept
+      -> read_errors {
+        std::uint64_t temp{0U};
+        for(unsigned shift = 0U; shift < 64U; shift += 7U) {
+            const auto bytes{ctx.source.fetch(1Z)};
+            if(MIRROR_UNLIKELY(bytes.empty())) {
+                return _not_enough_data(ctx);
+            }
+            const auto byte{std::to_integer<std::uint64_t>(bytes.front())};
+            // the tenth byte holds only the highest bit of the value
+            if(MIRROR_UNLIKELY(shift == 63U && (byte & 0x7EU) != 0U)) {
+                return {read_error_code::invalid_format};
+            }
+            temp |= (byte & 0x7FU) << shift;
+            if((byte & 0x80U) == 0U) {
+                if constexpr(sizeof(size_t) < sizeof(std::uint64_t)) {
+                    if(temp > std::numeric_limits<size_t>::max()) {
+                        return {read_error_code::invalid_format};
+                    }
+                }
+                value = size_t(temp);
+                return {};
+            }
+        }
+        return {read_error_code::invalid_format};
+    }
+};
+//------------------------------------------------------------------------------
+/// @brief Deserializes a value in the compact binary format from a data source.
+/// @ingroup serialization
+/// @see write_binary
+/// String views and byte spans read into @p value point into the memory
+/// returned by the source's fetch function.
+template <typename T, data_source Source>
+auto read_binary(T& value, Source& source) noexcept -> read_errors {
+    basic_binary_read_backend<Source> backend;
+    return read(value, backend, {source});
+}
+//------------------------------------------------------------------------------
+/// @brief Deserializes a value in the compact binary format from a buffer.
+/// @ingroup serialization
+/// @see write_binary
+/// All of the bytes in @p src must be consumed, otherwise the result contains
+/// read_error_code::unexpected_data.
+/// String views and byte spans read into @p value point into @p src, which
+/// must outlive them.
+template <typename T>
+auto read_binary(T& value, std::span<const std::byte> src) noexcept
+  -> read_errors {
+    span_data_source source{src};
+    auto errors{read_binary(value, source)};
+    if(!errors && source.remaining() > 0Z) {
+        errors |= read_error_code::unexpected_data;
+    }
+    return errors;
+}
+//------------------------------------------------------------------------------
+/// @brief Deserializes a value in the compact binary format from chunks.
+/// @ingroup serialization
+/// @see resumable_binary_writer
+/// @see resume_tracker
+///
+/// Each call to read_some adds the next chunk of the input and returns
+/// read_error_code::incomplete_read while the data received so far is not
+/// enough to read the whole value, so that it can be fed from non-blocking
+/// I/O as the data arrives. Between the calls the reader remembers the path
+/// to the list or record elements that could not be read yet and keeps only
+/// the input starting with them, the next call continues with these elements
+/// and the elements read before are kept in the value.
+/// The value must not contain string views or byte spans, because the input
+/// they would point into is dropped after it was read.
+template <typename T>
+class resumable_binary_reader {
+    static_assert(
+      !holds_input_views_v<T>,
+      "the views would point into the input dropped between the chunks");
+
+public:
+    resumable_binary_reader(T& value) noexcept
+      : _value{value} {}
+
+    /// @brief Consumes the next chunk of the input.
+    /// If @p last is true, then no more input is going to arrive and missing
+    /// data is reported as read_error_code::not_enough_data.
+    auto read_some(std::span<const std::byte> chunk, bool last = false) noexcept
+      -> read_errors {
+        try {
+            _buffer.insert(_buffer.end(), chunk.begin(), chunk.end());
+        } catch(...) {
+            return {read_error_code::data_source_error};
+        }
+        _tracker.restart();
+        // the buffer starts at the remembered element or at the beginning
+        _source source{_buffer, last, _base, _tracker};
+        auto errors{read_binary(_value, source)};
+        if(errors.has(read_error_code::incomplete_read)) {
+            const auto anchor{_tracker.anchor()};
+            _buffer.erase(
+              _buffer.begin(),
+              _buffer.begin() + std::ptrdiff_t(anchor - _base));
+            _base = anchor;
+            return {read_error_code::incomplete_read};
+        }
+        if(!errors && source.remaining() > 0Z) {
+            errors |= read_error_code::unexpected_data;
+        }
+        _buffer.clear();
+        _base = 0Z;
+        _tracker.reset();
+        return errors;
+    }
+
+    /// @brief Returns the number of bytes received but not read yet.
+    auto bytes_pending() const noexcept -> size_t {
+        return _buffer.size();
+    }
+
+private:
+    class _source : public chunked_data_source {
+    public:
+        _source(
+          std::span<const std::byte> src,
+          bool complete,
+          size_t base,
+          resume_tracker& tracker) noexcept
+          : chunked_data_source{src, complete}
+          , _base{base}
+          , _tracker{tracker} {}
+
+        void stall() noexcept {
+            chunked_data_source::stall();
+            _tracker.suspend();
+        }
+
+        auto tracker() const noexcept -> resume_tracker& {
+            return _tracker;
+        }
+
+        auto stream_position() const noexcept -> size_t {
+            return _base + position();
+        }
+
+    private:
+        size_t _base{0Z};
+        resume_tracker& _tracker;
+    };
+
+    T& _value;
+    resume_tracker _tracker;
+    std::vector<std::byte> _buffer;
+    // the stream position of the start of the buffer
+    size_t _base{0Z};
+};
+//------------------------------------------------------------------------------
+} // namespace mirror::serialize
+
+#endif // MIRROR_SERIALIZE_READ_BINARY_HPP
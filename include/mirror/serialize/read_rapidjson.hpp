@@ -11,10 +11,19 @@
 
 #include "../diagnostic.hpp"
 #include "../from_string.hpp"
+#include "../is_within_limits.hpp"
 #include "../tribool.hpp"
 #include "../utils/rapidjson.hpp"
 #include "read.hpp"
+#include <algorithm>
+#include <cstdint>
 #include <istream>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
 
 MIRROR_DIAG_PUSH()
 #if defined(__clang__)
@@ -24,6 +33,7 @@ MIRROR_DIAG_OFF(zero-as-null-pointer-constant)
 #include <rapidjson/error/en.h>
 #include <rapidjson/istreamwrapper.h>
 #include <rapidjson/rapidjson.h>
+#include <rapidjson/reader.h>
 
 #if defined(__clang__)
 MIRROR_DIAG_POP()
@@ -38,6 +48,7 @@ struct basic_rapidjson_read_backend {
     struct context {
         const node_type& parent;
         const node_type& node;
+        mutable typename node_type::ConstMemberIterator member{};
 
         context(
           const rapidjson::GenericDocument<Encoding, Allocator>& d) noexcept
@@ -54,6 +65,10 @@ struct basic_rapidjson_read_backend {
         return true;
     }
 
+    auto bitfield_as_list(context_param) noexcept -> bool {
+        return true;
+    }
+
     auto begin(context_param ctx) -> std::variant<context, read_errors> {
         return {ctx};
     }
@@ -150,12 +165,21 @@ struct basic_rapidjson_read_backend {
                     errors |= read_error_code::invalid_format;
                 }
             }
-        } else if constexpr(std::is_same_v<T, std::string>) {
+        } else if constexpr(is_char_string_v<T>) {
+            if(ctx.node.IsString()) {
+                value.assign(
+                  ctx.node.GetString(), ctx.node.GetStringLength());
+            } else {
+                errors |= read_error_code::invalid_format;
+            }
+        } else if constexpr(std::is_same_v<T, std::string_view>) {
             if(ctx.node.IsString()) {
-                value = ctx.node.GetString();
+                value = {ctx.node.GetString(), ctx.node.GetStringLength()};
             } else {
                 errors |= read_error_code::invalid_format;
             }
+        } else if constexpr(std::is_same_v<T, std::span<const std::byte>>) {
+            errors |= read_error_code::not_supported;
         } else {
             return drv.read(*this, ctx, value);
         }
@@ -191,11 +215,24 @@ struct basic_rapidjson_read_backend {
     auto begin_record(context_param ctx, size_t&)
       -> std::variant<context, read_errors> {
         if(ctx.node.IsObject()) {
-            return {ctx};
+            context subctx{ctx};
+            subctx.member = ctx.node.MemberBegin();
+            return {subctx};
         }
         return read_errors{read_error_code::invalid_format};
     }
 
+    auto has_next_attribute(context_param ctx) noexcept -> bool {
+        return ctx.member != ctx.node.MemberEnd();
+    }
+
+    auto next_attribute(context_param ctx, std::string_view& name)
+      -> std::variant<context, read_errors> {
+        const auto pos{ctx.member++};
+        name = {pos->name.GetString(), pos->name.GetStringLength()};
+        return {context{ctx, pos->value}};
+    }
+
     auto begin_attribute(context_param ctx, std::string_view name)
       -> std::variant<context, read_errors> {
         const auto pos = ctx.node.FindMember(to_rapidjson(name));
@@ -222,6 +259,599 @@ struct basic_rapidjson_read_backend {
     }
 };
 //------------------------------------------------------------------------------
+/// @brief Deserialization backend pulling values from in-situ parsed JSON text.
+/// @ingroup serialization
+/// @see basic_rapidjson_read_backend
+///
+/// Unlike basic_rapidjson_read_backend this does not build a document.
+/// The input text is consumed in the order in which the deserializer asks
+/// for the values, scalars are parsed in-situ by rapidjson::Reader so that
+/// strings are decoded in place without any allocation. Record members that
+/// appear in the input before they are requested are remembered only as
+/// a (name, position) pair and parsed when asked for. The element counts of
+/// a list and of all the lists nested in it are found in a single pass over
+/// its text when it begins and remembered for the nested lists. The input
+/// buffer must be mutable, zero-terminated and it is modified during parsing.
+class rapidjson_pull_read_backend {
+public:
+    struct context {
+        char* value{nullptr};
+        mutable char* cursor{nullptr};
+        mutable char* pending{nullptr};
+        size_t stash{0Z};
+        // the end of the pending value, if it was parsed before a stashed one
+        mutable char* pending_end{nullptr};
+    };
+    using context_param = const context&;
+
+    auto enum_as_string(context_param) noexcept -> bool {
+        return true;
+    }
+
+    auto bitfield_as_list(context_param) noexcept -> bool {
+        return true;
+    }
+
+    auto begin(context_param ctx) -> std::variant<context, read_errors> {
+        // forget the previous document, but keep the allocated storage
+        _stash.clear();
+        _lists.clear();
+        _next_list = 0Z;
+        _last_begin = nullptr;
+        _last_end = nullptr;
+        return {context{_skip_ws(ctx.value)}};
+    }
+
+    template <typename R, typename P>
+    auto read(
+      const read_driver&,
+      context_param ctx,
+      std::chrono::duration<R, P>& value) -> read_errors {
+        if(_parse_scalar(ctx.value) && _token.kind == token_kind::string) {
+            if(const auto opt_val{
+                 from_string<std::chrono::duration<R, P>>(_token.string)};
+               mirror::has_value(opt_val)) {
+                value = mirror::extract(opt_val);
+                return {};
+            }
+        }
+        return {read_error_code::invalid_format};
+    }
+
+    template <typename T>
+    auto read(const read_driver& drv, context_param ctx, T& value)
+      -> read_errors {
+        if constexpr(
+          std::is_arithmetic_v<T> || std::is_same_v<T, tribool> ||
+          is_char_string_v<T> || std::is_same_v<T, std::string_view>) {
+            if(MIRROR_UNLIKELY(!_parse_scalar(ctx.value))) {
+                return {read_error_code::invalid_format};
+            }
+            return _convert(value);
+        } else if constexpr(std::is_same_v<T, std::span<const std::byte>>) {
+            return {read_error_code::not_supported};
+        } else {
+            return drv.read(*this, ctx, value);
+        }
+    }
+
+    auto begin_list(context_param ctx, size_t& count)
+      -> std::variant<context, read_errors> {
+        if(*ctx.value == '[') {
+            if(const auto opt_count{_list_count(ctx.value)}) {
+                count = *opt_count;
+                return {
+                  context{ctx.value, _skip_ws(ctx.value + 1), nullptr, 0Z}};
+            }
+        }
+        return read_errors{read_error_code::invalid_format};
+    }
+
+    auto begin_element(context_param ctx, size_t)
+      -> std::variant<context, read_errors> {
+        char* p{_advance(ctx)};
+        if(MIRROR_UNLIKELY(!p)) {
+            return read_errors{read_error_code::invalid_format};
+        }
+        if(MIRROR_UNLIKELY(*p == ']')) {
+            return read_errors{read_error_code::missing_element};
+        }
+        ctx.pending = p;
+        return {context{p}};
+    }
+
+    template <typename T>
+    auto read_elements(context_param ctx, std::span<T> values) -> read_errors {
+        read_errors errors{};
+        for(T& value : values) {
+            char* p{_advance(ctx)};
+            if(MIRROR_UNLIKELY(!p || *p == ']')) {
+                return errors | read_errors{read_error_code::missing_element};
+            }
+            ctx.pending = p;
+            if(MIRROR_UNLIKELY(!_parse_scalar(p))) {
+                return errors | read_errors{read_error_code::invalid_format};
+            }
+            errors |= _convert(value);
+        }
+        return errors;
+    }
+
+    auto separate_element(context_param) -> read_errors {
+        return {};
+    }
+
+    auto finish_element(context_param, size_t) -> read_errors {
+        return {};
+    }
+
+    auto finish_list(context_param ctx) -> read_errors {
+        char* p{_advance(ctx)};
+        while(p && *p != ']') {
+            ctx.pending = p;
+            p = _advance(ctx);
+        }
+        if(MIRROR_UNLIKELY(!p)) {
+            return {read_error_code::invalid_format};
+        }
+        _last_begin = ctx.value;
+        _last_end = p + 1;
+        return {};
+    }
+
+    auto begin_record(context_param ctx, size_t&)
+      -> std::variant<context, read_errors> {
+        if(*ctx.value == '{') {
+            return {context{
+              ctx.value, _skip_ws(ctx.value + 1), nullptr, _stash.size()}};
+        }
+        return read_errors{read_error_code::invalid_format};
+    }
+
+    auto begin_attribute(context_param ctx, std::string_view name)
+      -> std::variant<context, read_errors> {
+        for(size_t i = ctx.stash; i < _stash.size(); ++i) {
+            if(_stash[i].name == name) {
+                // parsing the stashed value overwrites the end of the last
+                // parsed value and the text of the pending one is modified
+                if(ctx.pending && !ctx.pending_end) {
+                    if(_last_begin == ctx.pending) {
+                        ctx.pending_end = _last_end;
+                    }
+                }
+                return {context{_stash[i].value}};
+            }
+        }
+        while(true) {
+            char* p{_advance(ctx)};
+            if(MIRROR_UNLIKELY(!p)) {
+                return read_errors{read_error_code::invalid_format};
+            }
+            if(*p == '}') {
+                return read_errors{read_error_code::missing_member};
+            }
+            std::string_view key;
+            p = _parse_key(p, key);
+            if(MIRROR_UNLIKELY(!p)) {
+                return read_errors{read_error_code::invalid_format};
+            }
+            ctx.pending = p;
+            if(key == name) {
+                return {context{p}};
+            }
+            _stash.push_back({key, p});
+        }
+    }
+
+    auto has_next_attribute(context_param ctx) noexcept -> bool {
+        const char* p{_advance(ctx)};
+        return !p || *p != '}';
+    }
+
+    auto next_attribute(context_param ctx, std::string_view& name)
+      -> std::variant<context, read_errors> {
+        char* p{_advance(ctx)};
+        if(MIRROR_LIKELY(p)) {
+            if((p = _parse_key(p, name))) {
+                ctx.pending = p;
+                return {context{p}};
+            }
+        }
+        return read_errors{read_error_code::invalid_format};
+    }
+
+    auto separate_attribute(context_param) -> read_errors {
+        return {};
+    }
+
+    auto finish_attribute(context_param, std::string_view) -> read_errors {
+        return {};
+    }
+
+    auto finish_record(context_param ctx) -> read_errors {
+        _stash.resize(ctx.stash);
+        char* p{_advance(ctx)};
+        while(p && *p != '}') {
+            std::string_view key;
+            if((p = _parse_key(p, key))) {
+                ctx.pending = p;
+                p = _advance(ctx);
+            }
+        }
+        if(MIRROR_UNLIKELY(!p)) {
+            return {read_error_code::invalid_format};
+        }
+        _last_begin = ctx.value;
+        _last_end = p + 1;
+        return {};
+    }
+
+    auto finish(context_param ctx) -> read_errors {
+        char* p{
+          _last_begin == ctx.value ? _last_end : _skip_value(ctx.value)};
+        if(MIRROR_UNLIKELY(!p)) {
+            return {read_error_code::invalid_format};
+        }
+        if(*_skip_ws(p) != '\0') {
+            return {read_error_code::unexpected_data};
+        }
+        return {};
+    }
+
+private:
+    enum class token_kind {
+        none,
+        null,
+        boolean,
+        signed_int,
+        unsigned_int,
+        floating,
+        string
+    };
+
+    struct token : rapidjson::BaseReaderHandler<rapidjson::UTF8<>, token> {
+        token_kind kind{token_kind::none};
+        bool boolean{false};
+        std::int64_t signed_int{0};
+        std::uint64_t unsigned_int{0U};
+        double floating{0.0};
+        std::string_view string{};
+
+        auto Null() noexcept -> bool {
+            kind = token_kind::null;
+            return true;
+        }
+
+        auto Bool(bool b) noexcept -> bool {
+            kind = token_kind::boolean;
+            boolean = b;
+            return true;
+        }
+
+        auto Int(int i) noexcept -> bool {
+            return Int64(i);
+        }
+
+        auto Int64(std::int64_t i) noexcept -> bool {
+            kind = token_kind::signed_int;
+            signed_int = i;
+            return true;
+        }
+
+        auto Uint(unsigned u) noexcept -> bool {
+            return Uint64(u);
+        }
+
+        auto Uint64(std::uint64_t u) noexcept -> bool {
+            kind = token_kind::unsigned_int;
+            unsigned_int = u;
+            return true;
+        }
+
+        auto Double(double d) noexcept -> bool {
+            kind = token_kind::floating;
+            floating = d;
+            return true;
+        }
+
+        auto String(const char* s, rapidjson::SizeType l, bool) noexcept
+          -> bool {
+            kind = token_kind::string;
+            string = {s, l};
+            return true;
+        }
+    };
+
+    struct stashed_member {
+        std::string_view name;
+        char* value;
+    };
+
+    struct counted_list {
+        const char* begin;
+        size_t count;
+    };
+
+    rapidjson::Reader _reader;
+    token _token;
+    std::vector<stashed_member> _stash;
+    // the element counts of the lists seen so far, ordered by their position
+    std::vector<counted_list> _lists;
+    // the list that most likely begins next
+    size_t _next_list{0Z};
+    // the positions in _lists of the lists being counted, or the maximum
+    // size_t value for the records
+    std::vector<size_t> _nesting;
+    const char* _last_begin{nullptr};
+    char* _last_end{nullptr};
+
+    static auto _is_ws(char c) noexcept -> bool {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    static auto _skip_ws(char* p) noexcept -> char* {
+        while(_is_ws(*p)) {
+            ++p;
+        }
+        return p;
+    }
+
+    static auto _skip_string(char* p) noexcept -> char* {
+        for(++p;; ++p) {
+            if(*p == '"') {
+                return p + 1;
+            }
+            if(*p == '\\') {
+                ++p;
+            }
+            if(MIRROR_UNLIKELY(*p == '\0')) {
+                return nullptr;
+            }
+        }
+    }
+
+    // skips the raw text of a not yet parsed value without modifying it
+    static auto _skip_value(char* p) noexcept -> char* {
+        if(*p == '"') {
+            return _skip_string(p);
+        }
+        if(*p == '{' || *p == '[') {
+            size_t depth{0Z};
+            do {
+                if(*p == '"') {
+                    if(!(p = _skip_string(p))) {
+                        return nullptr;
+                    }
+                    continue;
+                }
+                if(*p == '{' || *p == '[') {
+                    ++depth;
+                } else if(*p == '}' || *p == ']') {
+                    --depth;
+                } else if(MIRROR_UNLIKELY(*p == '\0')) {
+                    return nullptr;
+                }
+                ++p;
+            } while(depth > 0Z);
+            return p;
+        }
+        char* const b{p};
+        while(*p != '\0' && *p != ',' && *p != ']' && *p != '}' &&
+              !_is_ws(*p)) {
+            ++p;
+        }
+        return p != b ? p : nullptr;
+    }
+
+    // returns the element count of the list beginning at p
+    auto _list_count(char* p) -> std::optional<size_t> {
+        if(_next_list < _lists.size() && _lists[_next_list].begin == p) {
+            return {_lists[_next_list++].count};
+        }
+        const auto pos{std::lower_bound(
+          _lists.begin(), _lists.end(), p, [](const auto& l, const char* b) {
+              return l.begin < b;
+          })};
+        if(pos != _lists.end() && pos->begin == p) {
+            _next_list = size_t(pos - _lists.begin()) + 1Z;
+            return {pos->count};
+        }
+        const size_t first{_lists.size()};
+        if(MIRROR_UNLIKELY(!_count_elements(p))) {
+            _lists.resize(first);
+            return {};
+        }
+        // lists in stashed members may precede the ones counted before
+        if(first > 0Z && _lists[first - 1Z].begin > p) {
+            std::inplace_merge(
+              _lists.begin(),
+              _lists.begin() + std::ptrdiff_t(first),
+              _lists.end(),
+              [](const auto& l, const auto& r) { return l.begin < r.begin; });
+            return _list_count(p);
+        }
+        _next_list = first + 1Z;
+        return {_lists[first].count};
+    }
+
+    // counts the elements of the list beginning at p and of all the lists
+    // nested in it, without modifying the text
+    auto _count_elements(char* p) -> bool {
+        constexpr const size_t record{std::numeric_limits<size_t>::max()};
+        _nesting.clear();
+        do {
+            if(*p == '"') {
+                if(MIRROR_UNLIKELY(!(p = _skip_string(p)))) {
+                    return false;
+                }
+                continue;
+            }
+            if(*p == '[') {
+                _nesting.push_back(_lists.size());
+                const char* const begin{p};
+                p = _skip_ws(p + 1);
+                // unless the list is empty, its first element begins here
+                _lists.push_back({begin, *p == ']' ? 0Z : 1Z});
+                continue;
+            }
+            if(*p == '{') {
+                _nesting.push_back(record);
+            } else if(*p == ',') {
+                if(_nesting.back() != record) {
+                    ++_lists[_nesting.back()].count;
+                }
+            } else if(*p == ']' || *p == '}') {
+                const bool in_list{_nesting.back() != record};
+                if(MIRROR_UNLIKELY(in_list != (*p == ']'))) {
+                    return false;
+                }
+                _nesting.pop_back();
+            } else if(MIRROR_UNLIKELY(*p == '\0')) {
+                return false;
+            }
+            ++p;
+        } while(!_nesting.empty());
+        return true;
+    }
+
+    // moves the cursor of a list or record context past the pending value
+    auto _advance(context_param ctx) noexcept -> char* {
+        char* p{ctx.cursor};
+        if(ctx.pending) {
+            if(ctx.pending_end) {
+                p = ctx.pending_end;
+            } else if(_last_begin == ctx.pending) {
+                p = _last_end;
+            } else {
+                p = _skip_value(ctx.pending);
+            }
+            ctx.pending = nullptr;
+            ctx.pending_end = nullptr;
+            if(MIRROR_UNLIKELY(!p)) {
+                return ctx.cursor = nullptr;
+            }
+            p = _skip_ws(p);
+            if(*p == ',') {
+                p = _skip_ws(p + 1);
+            } else if(MIRROR_UNLIKELY(*p != ']' && *p != '}')) {
+                p = nullptr;
+            }
+        }
+        return ctx.cursor = p;
+    }
+
+    auto _parse_scalar(char* p) noexcept -> bool {
+        _token.kind = token_kind::none;
+        if(MIRROR_UNLIKELY(!p || *p == '{' || *p == '[')) {
+            return false;
+        }
+        rapidjson::InsituStringStream stream{p};
+        const rapidjson::ParseResult result{
+          _reader.Parse<
+            rapidjson::kParseInsituFlag | rapidjson::kParseStopWhenDoneFlag>(
+            stream, _token)};
+        if(MIRROR_LIKELY(result)) {
+            _last_begin = p;
+            _last_end = p + stream.Tell();
+            return true;
+        }
+        return false;
+    }
+
+    // parses a member name and returns the position of the member value
+    auto _parse_key(char* p, std::string_view& key) noexcept -> char* {
+        if(MIRROR_UNLIKELY(*p != '"' || !_parse_scalar(p))) {
+            return nullptr;
+        }
+        key = _token.string;
+        p = _skip_ws(_last_end);
+        if(MIRROR_UNLIKELY(*p != ':')) {
+            return nullptr;
+        }
+        return _skip_ws(p + 1);
+    }
+
+    template <typename T>
+    auto _convert(T& value) const noexcept -> read_errors {
+        read_errors errors{};
+        if constexpr(std::is_same_v<T, bool>) {
+            if(_token.kind == token_kind::boolean) {
+                value = _token.boolean;
+            } else {
+                errors |= read_error_code::invalid_format;
+            }
+        } else if constexpr(std::is_same_v<T, tribool>) {
+            if(_token.kind == token_kind::boolean) {
+                value = _token.boolean;
+            } else if(_token.kind == token_kind::null) {
+                value = indeterminate;
+            } else {
+                errors |= read_error_code::invalid_format;
+            }
+        } else if constexpr(std::is_floating_point_v<T>) {
+            if(_token.kind == token_kind::floating) {
+                value = T(_token.floating);
+            } else if(_token.kind == token_kind::signed_int) {
+                value = T(_token.signed_int);
+            } else if(_token.kind == token_kind::unsigned_int) {
+                value = T(_token.unsigned_int);
+            } else {
+                errors |= read_error_code::invalid_format;
+            }
+        } else if constexpr(std::is_integral_v<T>) {
+            std::optional<T> opt_val{};
+            if(_token.kind == token_kind::signed_int) {
+                opt_val = convert_if_fits<T>(_token.signed_int);
+            } else if(_token.kind == token_kind::unsigned_int) {
+                opt_val = convert_if_fits<T>(_token.unsigned_int);
+            }
+            if(mirror::has_value(opt_val)) {
+                value = mirror::extract(opt_val);
+            } else {
+                errors |= read_error_code::invalid_format;
+            }
+        } else if constexpr(is_char_string_v<T>) {
+            if(_token.kind == token_kind::string) {
+                value.assign(_token.string);
+            } else {
+                errors |= read_error_code::invalid_format;
+            }
+        } else if constexpr(std::is_same_v<T, std::string_view>) {
+            if(_token.kind == token_kind::string) {
+                value = _token.string;
+            } else {
+                errors |= read_error_code::invalid_format;
+            }
+        }
+        return errors;
+    }
+};
+//------------------------------------------------------------------------------
+/// @brief Deserializes a value from mutable zero-terminated JSON text in-situ.
+/// @ingroup serialization
+/// @see rapidjson_pull_read_backend
+/// The content of @p json is modified during parsing. String views read
+/// into @p value point into @p json, which must outlive them.
+template <typename T>
+auto read_rapidjson_insitu(T& value, char* json) noexcept -> read_errors {
+    rapidjson_pull_read_backend backend;
+    return read(value, backend, {json});
+}
+//------------------------------------------------------------------------------
+/// @brief Deserializes a value from JSON text stored in a string, in-situ.
+/// @ingroup serialization
+/// @see rapidjson_pull_read_backend
+/// The content of @p json is modified during parsing. String views read
+/// into @p value point into @p json, which must outlive them.
+template <typename T>
+auto read_rapidjson_insitu(T& value, std::string& json) noexcept
+  -> read_errors {
+    return read_rapidjson_insitu(value, json.data());
+}
+//------------------------------------------------------------------------------
+/// @brief Deserializes a value from a parsed JSON document.
+/// @ingroup serialization
+/// String views read into @p value point into @p node, which must outlive them.
 template <typename T, typename E, typename A>
 auto read_rapidjson(
   T& value,
@@ -231,28 +861,36 @@ auto read_rapidjson(
     return read(value, backend, ctx);
 }
 //------------------------------------------------------------------------------
+/// @brief Deserializes a value from JSON text read from a stream.
+/// @ingroup serialization
+/// @see read_rapidjson_insitu
+/// The text is parsed in-situ in a temporary copy, so @p value must not
+/// contain string views or byte spans.
 template <typename T>
 auto read_rapidjson_stream(T& value, std::istream& in) -> read_errors {
-    rapidjson::BasicIStreamWrapper<std::istream> stream(in);
-    rapidjson::Document doc;
-    const rapidjson::ParseResult parse_result{doc.ParseStream(stream)};
-    if(parse_result) {
-        return read_rapidjson(value, doc);
-    } else {
-        return {read_error_code::invalid_format};
+    static_assert(
+      !holds_input_views_v<T>,
+      "the views would point into a temporary, use read_rapidjson_insitu");
+    std::string json{
+      std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    if(in.bad()) {
+        return {read_error_code::data_source_error};
     }
+    return read_rapidjson_insitu(value, json);
 }
 //------------------------------------------------------------------------------
+/// @brief Deserializes a value from JSON text in a string.
+/// @ingroup serialization
+/// @see read_rapidjson_insitu
+/// The text is parsed in-situ in a temporary copy, so @p value must not
+/// contain string views or byte spans.
 template <typename T>
 auto read_rapidjson_string(T& value, std::string_view json_str) -> read_errors {
-    rapidjson::Document doc;
-    const rapidjson::ParseResult parse_result{
-      doc.Parse(mirror::to_rapidjson(json_str))};
-    if(parse_result) {
-        return read_rapidjson(value, doc);
-    } else {
-        return {read_error_code::invalid_format};
-    }
+    static_assert(
+      !holds_input_views_v<T>,
+      "the views would point into a temporary, use read_rapidjson_insitu");
+    std::string json{json_str};
+    return read_rapidjson_insitu(value, json);
 }
 //------------------------------------------------------------------------------
 } // namespace mirror::serialize
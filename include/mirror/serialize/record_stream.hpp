@@ -0,0 +1,284 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef MIRROR_SERIALIZE_RECORD_STREAM_HPP
+#define MIRROR_SERIALIZE_RECORD_STREAM_HPP
+
+#include "read_binary.hpp"
+#include "read_rapidjson.hpp"
+#include "write_binary.hpp"
+#include "write_rapidjson.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace mirror::serialize {
+//------------------------------------------------------------------------------
+/// @brief Enumeration of the ways of delimiting records in a record stream.
+/// @ingroup serialization
+/// @see record_stream_reader
+/// @see record_stream_writer
+enum class record_framing : std::uint8_t {
+    /// @brief One JSON document per line (NDJSON).
+    json_lines,
+    /// @brief Compact binary records, each prefixed by its size as a varint.
+    binary_frames
+};
+//------------------------------------------------------------------------------
+/// @brief Reads a stream of records of type T, one at a time.
+/// @ingroup serialization
+/// @see record_stream_writer
+///
+/// A single input buffer and a single decoded value are reused for all the
+/// records, so memory use depends on the size of the largest record and not
+/// on the size of the stream. String views read into the value point into
+/// the buffer and stay valid only until the next record is read. Binary
+/// frames larger than the maximum frame size are skipped without reading
+/// them into the buffer and are reported as invalid format.
+template <typename T>
+class record_stream_reader {
+public:
+    /// @brief The default maximum size of a binary frame in bytes.
+    static constexpr const size_t default_max_frame_size{64Z * 1024Z * 1024Z};
+
+    record_stream_reader(
+      std::istream& in,
+      record_framing framing = record_framing::json_lines,
+      size_t max_frame_size = default_max_frame_size) noexcept
+      : _in{in}
+      , _max_frame_size{max_frame_size}
+      , _framing{framing} {}
+
+    /// @brief Reads the next record into value.
+    /// Returns false at the end of the stream or if the record could not be
+    /// read. In the latter case errors are set and calling next again skips
+    /// to the following record.
+    auto next() -> bool {
+        _errors = {};
+        if(_framing == record_framing::json_lines) {
+            return _next_line();
+        }
+        return _next_frame();
+    }
+
+    /// @brief Returns a reference to the last record read.
+    auto value() noexcept -> T& {
+        return _value;
+    }
+
+    /// @brief Returns the errors from reading the last record.
+    auto errors() const noexcept -> read_errors {
+        return _errors;
+    }
+
+    /// @brief Returns the number of records successfully read so far.
+    auto count() const noexcept -> size_t {
+        return _count;
+    }
+
+    /// @brief Input iterator over the records, reading them on increment.
+    class iterator {
+    public:
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() noexcept = default;
+        iterator(record_stream_reader* parent) noexcept
+          : _parent{parent} {}
+
+        auto operator*() const noexcept -> T& {
+            return _parent->value();
+        }
+
+        auto operator++() -> iterator& {
+            if(!_parent->next()) {
+                _parent = nullptr;
+            }
+            return *this;
+        }
+
+        void operator++(int) {
+            ++*this;
+        }
+
+        friend auto operator==(const iterator& i, std::default_sentinel_t)
+          -> bool {
+            return i._parent == nullptr;
+        }
+
+    private:
+        record_stream_reader* _parent{nullptr};
+    };
+
+    /// @brief Reads the next record and returns an iterator referring to it.
+    /// The iteration stops at the end of the stream or at the first error.
+    auto begin() -> iterator {
+        return {next() ? this : nullptr};
+    }
+
+    auto end() const noexcept -> std::default_sentinel_t {
+        return {};
+    }
+
+private:
+    auto _next_line() -> bool {
+        while(std::getline(_in, _line)) {
+            if(_line.find_first_not_of(" \t\r") == std::string::npos) {
+                continue;
+            }
+            _errors = read(_value, _json_backend, {_line.data()});
+            return _finish();
+        }
+        if(_in.bad()) {
+            _errors |= read_error_code::data_source_error;
+        }
+        return false;
+    }
+
+    auto _next_frame() -> bool {
+        std::uint64_t size{0U};
+        for(unsigned shift = 0U;; shift += 7U) {
+            const auto c{_in.get()};
+            if(c == std::istream::traits_type::eof()) {
+                // the end of the stream is expected only between frames
+                if(_in.bad()) {
+                    _errors |= read_error_code::data_source_error;
+                } else if(shift > 0U) {
+                    _errors |= read_error_code::not_enough_data;
+                }
+                return false;
+            }
+            // the tenth byte holds only the highest bit of the size
+            if(MIRROR_UNLIKELY(
+                 shift >= 64U || (shift == 63U && (c & 0x7E) != 0))) {
+                _errors |= read_error_code::invalid_format;
+                return false;
+            }
+            size |= (std::uint64_t(c) & 0x7FU) << shift;
+            if((c & 0x80) == 0) {
+                break;
+            }
+        }
+        if(MIRROR_UNLIKELY(size > _max_frame_size)) {
+            // the next call continues with the following frame
+            constexpr const auto max_skip{
+              std::uint64_t(std::numeric_limits<std::streamsize>::max())};
+            _in.ignore(std::streamsize(std::min(size, max_skip)));
+            _errors |= read_error_code::invalid_format;
+            return false;
+        }
+        _frame.resize(size_t(size));
+        if(MIRROR_UNLIKELY(!_in.read(
+             reinterpret_cast<char*>(_frame.data()),
+             std::streamsize(size)))) {
+            _errors |= read_error_code::not_enough_data;
+            return false;
+        }
+        _errors = read_binary(_value, std::span<const std::byte>(_frame));
+        return _finish();
+    }
+
+    auto _finish() noexcept -> bool {
+        if(MIRROR_LIKELY(!_errors)) {
+            ++_count;
+            return true;
+        }
+        return false;
+    }
+
+    std::istream& _in;
+    std::string _line;
+    std::vector<std::byte> _frame;
+    rapidjson_pull_read_backend _json_backend;
+    T _value{};
+    read_errors _errors{};
+    size_t _count{0Z};
+    size_t _max_frame_size;
+    record_framing _framing;
+};
+//------------------------------------------------------------------------------
+/// @brief Writes a stream of records of type T, one at a time.
+/// @ingroup serialization
+/// @see record_stream_reader
+///
+/// Each record is serialized into a reused buffer and then written out, so
+/// memory use depends on the size of the largest record.
+template <typename T>
+class record_stream_writer {
+public:
+    record_stream_writer(
+      std::ostream& out,
+      record_framing framing = record_framing::json_lines) noexcept
+      : _out{out}
+      , _framing{framing} {}
+
+    /// @brief Writes the specified record to the stream.
+    auto write(const T& value) -> write_errors {
+        // records that fail to serialize are not written at all
+        write_errors errors{};
+        if(_framing == record_framing::json_lines) {
+            errors |= write_rapidjson_string(value, _line);
+            if(MIRROR_LIKELY(!errors)) {
+                _line.push_back('\n');
+                _out.write(_line.data(), std::streamsize(_line.size()));
+            }
+        } else {
+            _frame.clear();
+            errors |= write_binary(value, _frame);
+            if(MIRROR_LIKELY(!errors)) {
+                _write_frame_size(_frame.size());
+                _out.write(
+                  reinterpret_cast<const char*>(_frame.data()),
+                  std::streamsize(_frame.size()));
+            }
+        }
+        if(MIRROR_UNLIKELY(!_out)) {
+            errors |= write_error_code::data_sink_error;
+        }
+        return errors;
+    }
+
+    /// @brief Writes all the records from the specified range.
+    template <typename Range>
+    auto write_all(const Range& records) -> write_errors {
+        write_errors errors{};
+        for(const T& value : records) {
+            errors |= write(value);
+        }
+        return errors;
+    }
+
+private:
+    void _write_frame_size(size_t size) {
+        std::array<char, 10Z> bytes{};
+        size_t len = 0Z;
+        while(size >= 0x80U) {
+            bytes[len++] = char((size & 0x7FU) | 0x80U);
+            size >>= 7U;
+        }
+        bytes[len++] = char(size);
+        _out.write(bytes.data(), std::streamsize(len));
+    }
+
+    std::ostream& _out;
+    std::string _line;
+    std::vector<std::byte> _frame;
+    record_framing _framing;
+};
+//------------------------------------------------------------------------------
+} // namespace mirror::serialize
+
+#endif // MIRROR_SERIALIZE_RECORD_STREAM_HPP
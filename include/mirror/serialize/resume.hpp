@@ -0,0 +1,178 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef MIRROR_SERIALIZE_RESUME_HPP
+#define MIRROR_SERIALIZE_RESUME_HPP
+
+#include "../branch_predict.hpp"
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace mirror::serialize {
+//------------------------------------------------------------------------------
+/// @brief Follows the nesting of lists and records to resume their processing.
+/// @ingroup serialization
+/// @see tracking_data_sink
+/// @see tracking_data_source
+///
+/// The backend reports the beginning and the end of each list or record and
+/// the beginning of each of their elements together with its position in
+/// the byte stream. When the sink or the source fails because the chunk is
+/// full or the input did not arrive yet, the path to the elements being
+/// processed is remembered, down to the deepest level whose (de)serializer
+/// asked for resume_index and thus can continue from any of its elements.
+///
+/// Only the levels that make up the whole of their parent element, without
+/// any other bytes before them, can be on that path.
+///
+/// On the next attempt the levels on that path are entered again without
+/// any input or output, their (de)serializers continue at the remembered
+/// elements and only the innermost of them is processed again, from its
+/// position in the stream returned by anchor. The anchor never moves back,
+/// if an attempt fails at a shallower element entered before the anchor, then
+/// the remembered path is kept.
+class resume_tracker {
+public:
+    /// @brief Starts the next attempt, resuming at the remembered element.
+    void restart() noexcept {
+        _levels.clear();
+        _seeking = !_path.empty();
+        _suspended = false;
+    }
+
+    /// @brief Forgets the remembered element, the next attempt starts over.
+    void reset() noexcept {
+        _path.clear();
+        restart();
+    }
+
+    /// @brief Indicates that the levels on the remembered path are re-entered.
+    /// In this state there should be no input or output.
+    auto is_seeking() const noexcept -> bool {
+        return _seeking;
+    }
+
+    /// @brief Returns the stream position of the remembered innermost element.
+    auto anchor() const noexcept -> size_t {
+        return _path.empty() ? 0Z : _path.back().start;
+    }
+
+    /// @brief Returns the element count of the level that is being re-entered.
+    auto resumed_count() const noexcept -> std::optional<size_t> {
+        if(_seeking && _levels.size() < _path.size()) {
+            return {_path[_levels.size()].count};
+        }
+        return {};
+    }
+
+    /// @brief Called when a list or record with @p count elements begins.
+    /// The @p pos is the stream position before the count, if any.
+    /// Returns false if the level could not be allocated.
+    auto enter_level(size_t count, size_t pos) noexcept -> bool {
+        // the levels on the path are known to start their parent element
+        const bool direct{
+          _seeking || pos == (_levels.empty() ? 0Z : _levels.back().start)};
+        try {
+            _levels.push_back({count, 0Z, 0Z, direct, false});
+            // suspend does not allocate
+            _path.reserve(_levels.size());
+        } catch(...) {
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief Called when the current list or record is finished.
+    void leave_level() noexcept {
+        if(MIRROR_LIKELY(!_levels.empty())) {
+            _levels.pop_back();
+        }
+    }
+
+    /// @brief Called when an element of the current level begins at @p pos.
+    void enter_element(size_t pos) noexcept {
+        if(MIRROR_LIKELY(!_levels.empty())) {
+            auto& level{_levels.back()};
+            ++level.next;
+            if(_seeking) {
+                const auto& point{_path[_levels.size() - 1Z]};
+                level.start = point.start;
+                _seeking = _levels.size() < _path.size();
+            } else {
+                level.start = pos;
+            }
+        }
+    }
+
+    /// @brief Returns the index of the element to continue the current level.
+    /// The caller must continue with that element, the preceding ones were
+    /// already processed in a previous attempt.
+    auto resume_index() noexcept -> size_t {
+        if(MIRROR_UNLIKELY(_levels.empty())) {
+            return 0Z;
+        }
+        auto& level{_levels.back()};
+        level.resumable = true;
+        if(_seeking) {
+            level.next = _path[_levels.size() - 1Z].index;
+        }
+        return level.next;
+    }
+
+    /// @brief Remembers the path to the current elements on the first failure.
+    void suspend() noexcept {
+        if(_suspended || _seeking) {
+            return;
+        }
+        _suspended = true;
+        size_t depth{0Z};
+        for(const auto& level : _levels) {
+            if(!level.direct || !level.resumable || level.next == 0Z) {
+                break;
+            }
+            ++depth;
+        }
+        // elements entered while seeking start before the anchor
+        const size_t start{depth > 0Z ? _levels[depth - 1Z].start : 0Z};
+        if(start < anchor()) {
+            return;
+        }
+        _path.clear();
+        for(const auto& level : std::span(_levels).first(depth)) {
+            _path.push_back({level.next - 1Z, level.count, level.start});
+        }
+    }
+
+private:
+    struct level_state {
+        size_t count{0Z};
+        // the number of elements begun so far
+        size_t next{0Z};
+        // the stream position of the last begun element
+        size_t start{0Z};
+        bool direct{false};
+        bool resumable{false};
+    };
+
+    struct resume_point {
+        size_t index{0Z};
+        size_t count{0Z};
+        size_t start{0Z};
+    };
+
+    std::vector<level_state> _levels;
+    std::vector<resume_point> _path;
+    bool _seeking{false};
+    bool _suspended{false};
+};
+//------------------------------------------------------------------------------
+} // namespace mirror::serialize
+
+#endif // MIRROR_SERIALIZE_RESUME_HPP
@@ -0,0 +1,193 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef MIRROR_SERIALIZE_SIZE_HPP
+#define MIRROR_SERIALIZE_SIZE_HPP
+
+#include "../bitfield.hpp"
+#include "../placeholder.hpp"
+#include "../sequence.hpp"
+#include "../tribool.hpp"
+#include "data_sink.hpp"
+#include "write_binary.hpp"
+#include <array>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace mirror::serialize {
+//------------------------------------------------------------------------------
+/// @brief Size of the compact binary representation common to all values of T.
+/// @ingroup serialization
+/// @see serialized_size
+///
+/// The value is empty if the size depends on the serialized value, for example
+/// for strings or containers of variable size, or if T is not supported.
+template <typename T>
+struct fixed_serialized_size {
+private:
+    static consteval auto _add(std::optional<size_t> l, std::optional<size_t> r)
+      -> std::optional<size_t> {
+        if(l && r) {
+            return {*l + *r};
+        }
+        return {};
+    }
+
+    template <__metaobject_id... M>
+    static consteval auto _sum(unpacked_metaobject_sequence<M...>)
+      -> std::optional<size_t> {
+        std::optional<size_t> result{0Z};
+        ((result = _add(
+            result,
+            fixed_serialized_size<
+              std::remove_cvref_t<__unrefltype(M)>>::value)),
+         ...);
+        return result;
+    }
+
+    static consteval auto _get() -> std::optional<size_t> {
+        if constexpr(
+          std::is_same_v<T, bool> || std::is_same_v<T, tribool>) {
+            return {1Z};
+        } else if constexpr(
+          std::is_integral_v<T> || std::is_same_v<T, float> ||
+          std::is_same_v<T, double>) {
+            return {sizeof(T)};
+        } else if constexpr(std::is_enum_v<T>) {
+            return fixed_serialized_size<std::underlying_type_t<T>>::value;
+        } else if constexpr(std::is_class_v<T>) {
+            if constexpr(reflects_record(mirror(T))) {
+                return _sum(
+                  filter(get_data_members(mirror(T)), not_(is_static(_1))));
+            } else {
+                return {};
+            }
+        } else {
+            return {};
+        }
+    }
+
+public:
+    static constexpr const std::optional<size_t> value{_get()};
+};
+//------------------------------------------------------------------------------
+// the size of the varint encoding of a list element count
+consteval auto _serialized_count_size(size_t count) noexcept -> size_t {
+    size_t result{1Z};
+    while(count >= 0x80U) {
+        count >>= 7U;
+        ++result;
+    }
+    return result;
+}
+//------------------------------------------------------------------------------
+struct _variable_serialized_size {
+    static constexpr const std::optional<size_t> value{};
+};
+//------------------------------------------------------------------------------
+template <typename A>
+struct fixed_serialized_size<std::basic_string<char, std::char_traits<char>, A>>
+  : _variable_serialized_size {};
+template <>
+struct fixed_serialized_size<std::string_view> : _variable_serialized_size {};
+template <size_t N>
+struct fixed_serialized_size<char[N]> : _variable_serialized_size {};
+template <typename T>
+struct fixed_serialized_size<std::optional<T>> : _variable_serialized_size {};
+template <typename T, typename A>
+struct fixed_serialized_size<std::vector<T, A>> : _variable_serialized_size {};
+template <typename T>
+struct fixed_serialized_size<std::span<T>> : _variable_serialized_size {};
+//------------------------------------------------------------------------------
+template <typename T, size_t N>
+struct fixed_serialized_size<std::span<T, N>> {
+private:
+    static consteval auto _get() -> std::optional<size_t> {
+        if(const auto elem{
+             fixed_serialized_size<std::remove_cv_t<T>>::value}) {
+            return {_serialized_count_size(N) + N * *elem};
+        }
+        return {};
+    }
+
+public:
+    static constexpr const std::optional<size_t> value{_get()};
+};
+//------------------------------------------------------------------------------
+template <typename T, size_t N>
+struct fixed_serialized_size<std::array<T, N>>
+  : fixed_serialized_size<std::span<T, N>> {};
+//------------------------------------------------------------------------------
+// the binary backend writes bitfields as their underlying integer
+template <typename T>
+struct fixed_serialized_size<bitfield<T>>
+  : fixed_serialized_size<typename bitfield<T>::value_type> {};
+//------------------------------------------------------------------------------
+template <typename... T>
+struct fixed_serialized_size<std::tuple<T...>> {
+private:
+    static consteval auto _get() -> std::optional<size_t> {
+        if constexpr((fixed_serialized_size<T>::value.has_value() && ...)) {
+            return {
+              _serialized_count_size(sizeof...(T)) +
+              (0Z + ... + *fixed_serialized_size<T>::value)};
+        } else {
+            return {};
+        }
+    }
+
+public:
+    static constexpr const std::optional<size_t> value{_get()};
+};
+//------------------------------------------------------------------------------
+/// @brief Indicates if all values of T have a binary representation of the
+/// same size, known at compile-time.
+/// @ingroup serialization
+/// @see serialized_size
+template <typename T>
+concept has_fixed_serialized_size =
+  fixed_serialized_size<std::remove_cvref_t<T>>::value.has_value();
+//------------------------------------------------------------------------------
+/// @brief Returns the size of the compact binary representation of any T.
+/// @ingroup serialization
+/// @see write_binary
+///
+/// This can be used to size a buffer, for example a std::array on the stack.
+template <has_fixed_serialized_size T>
+consteval auto serialized_size() noexcept -> size_t {
+    return *fixed_serialized_size<std::remove_cvref_t<T>>::value;
+}
+//------------------------------------------------------------------------------
+/// @brief Returns the exact size of the compact binary representation of value.
+/// @ingroup serialization
+/// @see write_binary
+///
+/// For types without a fixed size this traverses the value with the binary
+/// serialization backend writing into a counting_data_sink, so that the output
+/// buffer can be allocated exactly once before the actual write. The errors
+/// of that traversal are added to @p errors, the size is not valid if any.
+template <typename T>
+auto serialized_size(const T& value, write_errors& errors) noexcept -> size_t {
+    if constexpr(has_fixed_serialized_size<T>) {
+        return serialized_size<T>();
+    } else {
+        counting_data_sink sink;
+        basic_binary_write_backend<counting_data_sink> backend;
+        errors |= write(value, backend, {sink});
+        return sink.size();
+    }
+}
+//------------------------------------------------------------------------------
+} // namespace mirror::serialize
+
+#endif // MIRROR_SERIALIZE_SIZE_HPP
@@ -0,0 +1,355 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef MIRROR_SERIALIZE_VERSIONED_HPP
+#define MIRROR_SERIALIZE_VERSIONED_HPP
+
+#include "../full_name.hpp"
+#include "../name_index.hpp"
+#include "read.hpp"
+#include "size.hpp"
+#include "write.hpp"
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace mirror::serialize {
+//------------------------------------------------------------------------------
+consteval auto _layout_hash(std::uint64_t h, std::string_view s) noexcept
+  -> std::uint64_t {
+    for(const char c : s) {
+        h ^= std::uint8_t(c);
+        h *= 0x100000001b3ULL;
+    }
+    // terminates the string so that adjacent names cannot run together
+    h ^= 0xFFU;
+    h *= 0x100000001b3ULL;
+    return h;
+}
+
+/// @brief Returns the fingerprint of the layout of the data members of T.
+/// @ingroup serialization
+/// @see versioned
+///
+/// The fingerprint is derived from the names and the full names of the types
+/// of the non-static data members, with the aliases resolved, in the order
+/// of their declaration.
+template <typename T>
+consteval auto layout_fingerprint() noexcept -> std::uint64_t {
+    std::uint64_t result{0xcbf29ce484222325ULL};
+    for_each(
+      filter(get_data_members(mirror(T)), not_(is_static(_1))),
+      [&](auto mdm) {
+          result = _layout_hash(result, get_name(mdm));
+          result = _layout_hash(
+            result, get_full_name(remove_all_aliases(get_type(mdm))));
+      });
+    return result;
+}
+//------------------------------------------------------------------------------
+/// @brief Selects the versioned encoding of a record, tolerating its changes.
+/// @ingroup serialization
+/// @see as_versioned
+/// @see layout_fingerprint
+///
+/// Wraps a reference to a record. When read, attributes that are not data
+/// members of the record are skipped and data members without an attribute
+/// keep their current values, so the record should be initialized with
+/// the defaults before reading. Neither is reported as an error.
+///
+/// With backends supporting framing, like the binary one, the record is
+/// written with its layout fingerprint and each attribute with its name and
+/// size. Unknown attributes are then skipped without decoding them and if
+/// the fingerprint matches that of the reader, the attributes are read in
+/// order without looking up their names. Attributes whose size shows that
+/// the type of their member changed are skipped too, and an attribute whose
+/// value does not fill its frame exactly is reported as invalid format.
+/// Other backends, like the JSON ones, write and read versioned records as
+/// regular records.
+template <typename Record>
+class versioned {
+public:
+    constexpr versioned(Record& record) noexcept
+      : _record{record} {}
+
+    /// @brief Returns a reference to the wrapped record.
+    constexpr auto record() const noexcept -> Record& {
+        return _record;
+    }
+
+private:
+    Record& _record;
+};
+//------------------------------------------------------------------------------
+/// @brief Wraps the specified record for versioned serialization.
+/// @ingroup serialization
+/// @see versioned
+///
+/// The returned wrapper can be written directly, but reading requires
+/// a non-const lvalue, so store the wrapper in a variable first and pass
+/// that variable to read or read_binary.
+template <typename T>
+constexpr auto as_versioned(T& record) noexcept -> versioned<T> {
+    return {record};
+}
+//------------------------------------------------------------------------------
+template <typename T>
+struct serializer<versioned<const T>> {
+    template <write_backend Backend>
+    auto write(
+      const write_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      const versioned<const T>& wrapped) const noexcept -> write_errors {
+        if constexpr(framed_write_backend<Backend>) {
+            const T& value{wrapped.record()};
+            write_errors errors{};
+            const auto mdms{
+              filter(get_data_members(mirror(T)), not_(is_static(_1)))};
+            auto subctx{backend.begin_framed_record(
+              ctx, layout_fingerprint<T>(), get_size(mdms))};
+            if(MIRROR_LIKELY(has_value(subctx))) {
+                for_each(mdms, [&](auto mdm) {
+                    const auto& member{get_value(mdm, value)};
+                    const auto size{serialized_size(member, errors)};
+                    errors |= backend.write_frame_header(
+                      extract(subctx), get_name(mdm), size);
+                    errors |= driver.write(backend, extract(subctx), member);
+                });
+                errors |= backend.finish_record(extract(subctx));
+            } else {
+                errors |= std::get<write_errors>(subctx);
+            }
+            return errors;
+        } else {
+            return driver.write(backend, ctx, wrapped.record());
+        }
+    }
+};
+//------------------------------------------------------------------------------
+template <typename T>
+struct serializer<versioned<T>> : serializer<versioned<const T>> {
+    template <write_backend Backend>
+    auto write(
+      const write_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      const versioned<T>& wrapped) const noexcept -> write_errors {
+        return serializer<versioned<const T>>::write(
+          driver, backend, ctx, as_versioned(std::as_const(wrapped.record())));
+    }
+};
+//------------------------------------------------------------------------------
+template <typename T>
+struct deserializer<versioned<T>> {
+private:
+    template <read_backend Backend, __metaobject_id M>
+    static auto _read_member(
+      const read_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      T& value) noexcept -> read_errors {
+        return driver.read(
+          backend, ctx, get_reference(wrapped_metaobject<M>{}, value));
+    }
+
+    // reads the value of a known attribute, which must fill its whole frame
+    template <framed_read_backend Backend, typename Reader>
+    static auto _read_frame(
+      const read_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      T& value,
+      Reader reader,
+      std::optional<size_t> fixed_size,
+      size_t size) noexcept -> read_errors {
+        if(fixed_size && *fixed_size != size) {
+            // the type of the member changed, it keeps its value
+            return backend.skip_frame(ctx, size);
+        }
+        if constexpr(requires { backend.frame_position(ctx); }) {
+            const size_t start{backend.frame_position(ctx)};
+            read_errors errors{reader(driver, backend, ctx, value)};
+            if(MIRROR_UNLIKELY(
+                 !errors && backend.frame_position(ctx) - start != size)) {
+                errors |= read_error_code::invalid_format;
+            }
+            return errors;
+        } else {
+            return reader(driver, backend, ctx, value);
+        }
+    }
+
+    template <framed_read_backend Backend, __metaobject_id... M>
+    static auto _read_framed(
+      const read_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      T& value,
+      unpacked_metaobject_sequence<M...>) noexcept -> read_errors {
+        using reader_t = read_errors (*)(
+          const read_driver&, Backend&, typename Backend::context_param, T&);
+        static constexpr name_index<sizeof...(M)> index{
+          {{get_name(wrapped_metaobject<M>{})...}}};
+        static constexpr std::array<reader_t, sizeof...(M)> readers{
+          {&_read_member<Backend, M>...}};
+        static constexpr std::array<std::string_view, sizeof...(M)> names{
+          {get_name(wrapped_metaobject<M>{})...}};
+        static constexpr std::array<std::optional<size_t>, sizeof...(M)> sizes{
+          {fixed_serialized_size<
+            std::remove_cvref_t<__unrefltype(M)>>::value...}};
+
+        read_errors errors{};
+        std::uint64_t layout{0U};
+        size_t count{0Z};
+        auto subctx{backend.begin_framed_record(ctx, layout, count)};
+        if(MIRROR_LIKELY(has_value(subctx))) {
+            std::string_view name;
+            size_t size{0Z};
+            if(layout == layout_fingerprint<T>() && count == sizeof...(M)) {
+                // same layout, the attributes are in the reader's order
+                for(size_t idx = 0; idx < sizeof...(M) && !errors; ++idx) {
+                    errors |=
+                      backend.read_frame_header(extract(subctx), name, size);
+                    if(MIRROR_UNLIKELY(!errors && name != names[idx])) {
+                        errors |= read_error_code::invalid_format;
+                    }
+                    if(MIRROR_UNLIKELY(errors)) {
+                        break;
+                    }
+                    errors |= _read_frame(
+                      driver,
+                      backend,
+                      extract(subctx),
+                      value,
+                      readers[idx],
+                      sizes[idx],
+                      size);
+                }
+            } else {
+                for(size_t idx = 0; idx < count && !errors; ++idx) {
+                    errors |=
+                      backend.read_frame_header(extract(subctx), name, size);
+                    if(MIRROR_UNLIKELY(errors)) {
+                        break;
+                    }
+                    if(const auto pos{index.find(name)}) {
+                        errors |= _read_frame(
+                          driver,
+                          backend,
+                          extract(subctx),
+                          value,
+                          readers[*pos],
+                          sizes[*pos],
+                          size);
+                    } else {
+                        errors |= backend.skip_frame(extract(subctx), size);
+                    }
+                }
+            }
+            errors |= backend.finish_record(extract(subctx));
+        } else {
+            errors |= std::get<read_errors>(subctx);
+        }
+        return errors;
+    }
+
+    template <attribute_iterating_read_backend Backend, __metaobject_id... M>
+    static auto _read_iterating(
+      const read_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      T& value,
+      unpacked_metaobject_sequence<M...>) noexcept -> read_errors {
+        using reader_t = read_errors (*)(
+          const read_driver&, Backend&, typename Backend::context_param, T&);
+        static constexpr name_index<sizeof...(M)> index{
+          {{get_name(wrapped_metaobject<M>{})...}}};
+        static constexpr std::array<reader_t, sizeof...(M)> readers{
+          {&_read_member<Backend, M>...}};
+
+        read_errors errors{};
+        size_t count{sizeof...(M)};
+        auto subctx{backend.begin_record(ctx, count)};
+        if(MIRROR_LIKELY(has_value(subctx))) {
+            while(backend.has_next_attribute(extract(subctx))) {
+                std::string_view name;
+                auto subsubctx{backend.next_attribute(extract(subctx), name)};
+                if(MIRROR_UNLIKELY(!has_value(subsubctx))) {
+                    errors |= std::get<read_errors>(subsubctx);
+                    break;
+                }
+                if(const auto pos{index.find(name)}) {
+                    errors |=
+                      readers[*pos](driver, backend, extract(subsubctx), value);
+                }
+                errors |= backend.finish_attribute(extract(subsubctx), name);
+            }
+            errors |= backend.finish_record(extract(subctx));
+        } else {
+            errors |= std::get<read_errors>(subctx);
+        }
+        return errors;
+    }
+
+    template <read_backend Backend>
+    static auto _read_by_name(
+      const read_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      T& value) noexcept -> read_errors {
+        const auto mdms{
+          filter(get_data_members(mirror(T)), not_(is_static(_1)))};
+        read_errors errors{};
+        size_t count{get_size(mdms)};
+        auto subctx{backend.begin_record(ctx, count)};
+        if(MIRROR_LIKELY(has_value(subctx))) {
+            for_each(mdms, [&](auto mdm) {
+                const auto name{get_name(mdm)};
+                auto subsubctx{backend.begin_attribute(extract(subctx), name)};
+                // absent members keep their values
+                if(has_value(subsubctx)) {
+                    errors |= driver.read(
+                      backend, extract(subsubctx), get_reference(mdm, value));
+                    errors |=
+                      backend.finish_attribute(extract(subsubctx), name);
+                }
+            });
+            errors |= backend.finish_record(extract(subctx));
+        } else {
+            errors |= std::get<read_errors>(subctx);
+        }
+        return errors;
+    }
+
+public:
+    template <read_backend Backend>
+    auto read(
+      const read_driver& driver,
+      Backend& backend,
+      typename Backend::context_param ctx,
+      versioned<T>& wrapped) const noexcept -> read_errors {
+        T& value{wrapped.record()};
+        const auto mdms{
+          filter(get_data_members(mirror(T)), not_(is_static(_1)))};
+        if constexpr(framed_read_backend<Backend>) {
+            return _read_framed(driver, backend, ctx, value, unpack(mdms));
+        } else if constexpr(attribute_iterating_read_backend<Backend>) {
+            return _read_iterating(driver, backend, ctx, value, unpack(mdms));
+        } else {
+            return _read_by_name(driver, backend, ctx, value);
+        }
+    }
+};
+//------------------------------------------------------------------------------
+} // namespace mirror::serialize
+
+#endif // MIRROR_SERIALIZE_VERSIONED_HPP
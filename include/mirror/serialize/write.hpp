@@ -10,6 +10,7 @@
 #define MIRROR_SERIALIZE_WRITE_HPP
 
 #include "../branch_predict.hpp"
+#include "../enum_utils.hpp"
 #include "../extract.hpp"
 #include "../placeholder.hpp"
 #include "../sequence.hpp"
@@ -18,6 +19,8 @@
 #include <array>
 #include <optional>
 #include <span>
+#include <string>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 #include <variant>
@@ -89,8 +92,12 @@ template <>
 struct serializer<double> : plain_serializer<double> {};
 template <>
 struct serializer<std::string_view> : plain_serializer<std::string_view> {};
+template <typename A>
+struct serializer<std::basic_string<char, std::char_traits<char>, A>>
+  : plain_serializer<std::string_view> {};
 template <>
-struct serializer<std::string> : plain_serializer<std::string_view> {};
+struct serializer<std::span<const std::byte>>
+  : plain_serializer<std::span<const std::byte>> {};
 template <size_t N>
 struct serializer<const char[N]> : plain_serializer<std::string_view> {};
 template <size_t N>
@@ -98,6 +105,20 @@ struct serializer<char[N]> : plain_serializer<std::string_view> {};
 //------------------------------------------------------------------------------
 template <typename T>
 struct serializer<bitfield<T>> {
+private:
+    // the backends that do not choose get the list of the set bits
+    template <write_backend Backend>
+    static auto _as_list(
+      Backend& backend,
+      typename Backend::context_param ctx) noexcept -> bool {
+        if constexpr(requires { backend.bitfield_as_list(ctx); }) {
+            return backend.bitfield_as_list(ctx);
+        } else {
+            return true;
+        }
+    }
+
+public:
     template <write_backend Backend>
     auto write(
       const write_driver& driver,
@@ -105,6 +126,10 @@ struct serializer<bitfield<T>> {
       typename Backend::context_param ctx,
       const bitfield<T>& value) const noexcept {
 
+        if(!_as_list(backend, ctx)) {
+            return driver.write(backend, ctx, value.bits());
+        }
+
         const auto mes = get_enumerators(mirror(T));
         write_errors errors{};
         const size_t size{
@@ -164,18 +189,29 @@ struct serializer<std::span<const T, N>> {
         write_errors errors{};
         auto subctx{backend.begin_list(ctx, value.size())};
         if(MIRROR_LIKELY(has_value(subctx))) {
-            size_t idx = 0;
-            bool first = true;
-            for(const auto& elem : value) {
-                if(first) {
-                    first = false;
-                } else {
-                    errors |= backend.separate_element(extract(subctx));
+            if constexpr(bulk_write_backend<Backend, std::remove_cv_t<T>>) {
+                errors |= backend.write_elements(
+                  extract(subctx), std::span<const T>(value));
+            } else {
+                size_t idx{0Z};
+                if constexpr(resumable_write_backend<Backend>) {
+                    idx = backend.resume_index(extract(subctx));
+                }
+                for(; idx < value.size(); ++idx) {
+                    if(idx > 0Z) {
+                        errors |= backend.separate_element(extract(subctx));
+                    }
+                    auto subsubctx{
+                      backend.begin_element(extract(subctx), idx)};
+                    errors |=
+                      driver.write(backend, extract(subsubctx), value[idx]);
+                    errors |= backend.finish_element(extract(subsubctx), idx);
+                    // the rest is written when the write is resumed
+                    if(MIRROR_UNLIKELY(
+                         errors.has(write_error_code::incomplete_write))) {
+                        break;
+                    }
                 }
-                auto subsubctx{backend.begin_element(extract(subctx), idx)};
-                errors |= driver.write(backend, extract(subsubctx), elem);
-                errors |= backend.finish_element(extract(subsubctx), idx);
-                ++idx;
             }
             errors |= backend.finish_list(extract(subctx));
         } else {
@@ -225,6 +261,7 @@ private:
       Backend&,
       Ctx&,
       const Tup&,
+      size_t,
       std::index_sequence<>) const noexcept {
         return write_errors{};
     }
@@ -240,17 +277,25 @@ private:
       Backend& backend,
       Ctx& ctx,
       const Tup& value,
+      size_t first,
       std::index_sequence<I, Is...>) const {
         write_errors errors{};
-        auto subctx{backend.begin_element(extract(ctx), I)};
-        if(I > 0Z) {
-            errors |= backend.separate_element(extract(ctx));
+        if(I >= first) {
+            auto subctx{backend.begin_element(extract(ctx), I)};
+            if(I > 0Z) {
+                errors |= backend.separate_element(extract(ctx));
+            }
+            errors |=
+              driver.write(backend, extract(subctx), std::get<I>(value));
+            errors |= backend.finish_element(extract(subctx), I);
+            if(MIRROR_UNLIKELY(
+                 errors.has(write_error_code::incomplete_write))) {
+                return errors;
+            }
         }
-        errors |= driver.write(backend, extract(subctx), std::get<I>(value));
-        errors |= backend.finish_element(extract(subctx), I);
 
-        errors |=
-          _do_write(driver, backend, ctx, value, std::index_sequence<Is...>{});
+        errors |= _do_write(
+          driver, backend, ctx, value, first, std::index_sequence<Is...>{});
 
         return errors;
     }
@@ -265,11 +310,16 @@ public:
         write_errors errors{};
         auto subctx{backend.begin_list(ctx, sizeof...(T))};
         if(MIRROR_LIKELY(has_value(subctx))) {
-            _do_write(
+            size_t first{0Z};
+            if constexpr(resumable_write_backend<Backend>) {
+                first = backend.resume_index(extract(subctx));
+            }
+            errors |= _do_write(
               driver,
               backend,
               subctx,
               value,
+              first,
               std::make_index_sequence<sizeof...(T)>{});
             errors |= backend.finish_list(extract(subctx));
         } else {
@@ -294,11 +344,19 @@ private:
         const auto mdms{filter(get_data_members(mt), not_(is_static(_1)))};
         auto subctx{backend.begin_record(ctx, get_size(mdms))};
         if(has_value(subctx)) {
-            bool first = true;
+            size_t first{0Z};
+            if constexpr(resumable_write_backend<Backend>) {
+                first = backend.resume_index(extract(subctx));
+            }
+            size_t idx{0Z};
             for_each(mdms, [&](auto mdm) {
-                if(first) {
-                    first = false;
-                } else {
+                // skips the members written before or after an incomplete one
+                if(
+                  idx++ < first ||
+                  errors.has(write_error_code::incomplete_write)) {
+                    return;
+                }
+                if(idx > 1Z) {
                     errors |= backend.separate_attribute(extract(subctx));
                 }
                 const auto name{get_name(mdm)};
@@ -328,13 +386,13 @@ private:
       metaobject auto mt) const noexcept -> write_errors
       requires(reflects_enum(mt)) {
         write_errors errors{};
-        const auto mes{get_enumerators(mt)};
         if(backend.enum_as_string(ctx)) {
-            for_each(mes, [&](auto me) {
-                if(get_constant(me) == value) {
-                    errors |= driver.write(backend, ctx, get_name(me));
-                }
-            });
+            const auto name{enum_lookup<T>::name_of(value)};
+            if(MIRROR_LIKELY(!name.empty())) {
+                errors |= driver.write(backend, ctx, name);
+            } else {
+                errors |= write_error_code::not_supported;
+            }
         } else {
             errors |= driver.write(
               backend, ctx, static_cast<std::underlying_type_t<T>>(value));
@@ -12,6 +12,9 @@
 #include "../extract.hpp"
 #include "result.hpp"
 #include <concepts>
+#include <cstdint>
+#include <span>
+#include <type_traits>
 
 namespace mirror::serialize {
 struct write_driver;
@@ -86,6 +89,60 @@ concept write_backend = requires(T v) {
     ->std::same_as<write_errors>;
 };
 
+/// @brief Concept for write backends writing contiguous ranges in one call.
+/// @ingroup serialization
+/// Such backends write all the elements of a list of arithmetic values of
+/// type E at once, between begin_list and finish_list, instead of having
+/// the serializer write them one by one.
+template <typename T, typename E>
+concept bulk_write_backend = write_backend<T> && std::is_arithmetic_v<E> &&
+  requires(T v) {
+    {
+        v.write_elements(
+          std::declval<typename T::context&>(),
+          std::declval<std::span<const E>>())
+    }
+    ->std::same_as<write_errors>;
+};
+
+/// @brief Concept for write backends framing the attributes of records.
+/// @ingroup serialization
+/// Such backends can write versioned records, starting with a fingerprint of
+/// the layout of the record, where each attribute is preceded by its name and
+/// by the size of its encoded value, so that readers can skip the attributes
+/// they do not know without decoding them. The sizes are those of the compact
+/// binary encoding, as returned by serialized_size.
+template <typename T>
+concept framed_write_backend = write_backend<T> && requires(T v) {
+    {
+        v.begin_framed_record(
+          std::declval<typename T::context&>(),
+          std::declval<std::uint64_t>(),
+          std::declval<size_t>())
+    }
+    ->extractable;
+
+    {
+        v.write_frame_header(
+          std::declval<typename T::context&>(),
+          std::declval<std::string_view>(),
+          std::declval<size_t>())
+    }
+    ->std::same_as<write_errors>;
+};
+
+/// @brief Concept for write backends able to resume an interrupted write.
+/// @ingroup serialization
+/// @see resume_tracker
+/// Serializers of lists and records call resume_index right after beginning
+/// them and continue with the element at the returned index, the elements
+/// before it were already written by a previous attempt.
+template <typename T>
+concept resumable_write_backend = write_backend<T> && requires(T v) {
+    { v.resume_index(std::declval<typename T::context&>()) }
+    ->std::convertible_to<size_t>;
+};
+
 } // namespace mirror::serialize
 
 #endif
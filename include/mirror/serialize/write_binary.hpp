@@ -0,0 +1,405 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef MIRROR_SERIALIZE_WRITE_BINARY_HPP
+#define MIRROR_SERIALIZE_WRITE_BINARY_HPP
+
+#include "../tribool.hpp"
+#include "data_sink.hpp"
+#include "write.hpp"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace mirror::serialize {
+//------------------------------------------------------------------------------
+/// @brief Serialization backend producing a compact binary representation.
+/// @ingroup serialization
+/// @see basic_binary_read_backend
+///
+/// Scalars are written as fixed-width little-endian values, floating-point
+/// values as their IEEE-754 bit patterns, strings, blocks of bytes and lists
+/// are prefixed by their size encoded as an unsigned LEB128 varint. Records
+/// are written as the sequence of their data members without any names or
+/// framing. Versioned records are written as the fingerprint of their layout
+/// and the number of their attributes, followed by the name, the size and
+/// the value of each of the attributes.
+template <data_sink Sink>
+struct basic_binary_write_backend {
+private:
+    // the types whose fixed-size encoding matches the in-memory representation
+    // on little-endian platforms
+    template <typename T>
+    static constexpr bool _is_scalar =
+      std::is_integral_v<T> || std::is_same_v<T, float> ||
+      std::is_same_v<T, double>;
+
+public:
+    struct context {
+        Sink& sink;
+    };
+    using context_param = context;
+
+    auto enum_as_string(context_param) noexcept -> bool {
+        return false;
+    }
+
+    auto bitfield_as_list(context_param) noexcept -> bool {
+        return false;
+    }
+
+    auto begin(context_param ctx) -> std::variant<context, write_errors> {
+        return {ctx};
+    }
+
+    template <typename T>
+    auto write(const write_driver& drv, context_param ctx, const T& value)
+      -> write_errors {
+        if constexpr(_is_scalar<T>) {
+            return _write_scalar(ctx, value);
+        } else if constexpr(std::is_same_v<T, tribool>) {
+            return _write_fixed(
+              ctx,
+              std::uint8_t(
+                value.is(indeterminate) ? 2U
+                : value                 ? 1U
+                                        : 0U));
+        } else if constexpr(std::is_convertible_v<T, std::string_view>) {
+            const std::string_view view{value};
+            return _write_bytes(ctx, std::as_bytes(std::span(view)));
+        } else if constexpr(std::is_same_v<T, std::span<const std::byte>>) {
+            return _write_bytes(ctx, value);
+        } else {
+            return drv.write(*this, ctx, value);
+        }
+    }
+
+    auto begin_list(context_param ctx, size_t count)
+      -> std::variant<context, write_errors> {
+        const auto start{_position(ctx)};
+        const auto errors{_write_varint(ctx, count)};
+        if(MIRROR_UNLIKELY(errors)) {
+            return errors;
+        }
+        return _enter_level(ctx, count, start);
+    }
+
+    template <typename T>
+    auto write_elements(context_param ctx, std::span<const T> values)
+      -> write_errors
+      requires(_is_scalar<T>) {
+        if constexpr(std::endian::native == std::endian::little) {
+            return ctx.sink.append(std::as_bytes(values));
+        } else {
+            write_errors errors{};
+            for(const T value : values) {
+                errors |= _write_scalar(ctx, value);
+            }
+            return errors;
+        }
+    }
+
+    auto begin_element(context_param ctx, size_t)
+      -> std::variant<context, write_errors> {
+        _enter_element(ctx);
+        return {ctx};
+    }
+
+    auto separate_element(context_param) -> write_errors {
+        return {};
+    }
+
+    auto finish_element(context_param, size_t) -> write_errors {
+        return {};
+    }
+
+    auto finish_list(context_param ctx) -> write_errors {
+        _leave_level(ctx);
+        return {};
+    }
+
+    auto begin_record(context_param ctx, size_t count)
+      -> std::variant<context, write_errors> {
+        return _enter_level(ctx, count, _position(ctx));
+    }
+
+    auto begin_attribute(context_param ctx, std::string_view)
+      -> std::variant<context, write_errors> {
+        _enter_element(ctx);
+        return {ctx};
+    }
+
+    auto separate_attribute(context_param) -> write_errors {
+        return {};
+    }
+
+    auto finish_attribute(context_param, std::string_view) -> write_errors {
+        return {};
+    }
+
+    auto finish_record(context_param ctx) -> write_errors {
+        _leave_level(ctx);
+        return {};
+    }
+
+    auto begin_framed_record(
+      context_param ctx,
+      std::uint64_t layout,
+      size_t count) -> std::variant<context, write_errors> {
+        const auto errors{_write_fixed(ctx, layout)};
+        if(MIRROR_UNLIKELY(errors)) {
+            return errors;
+        }
+        return begin_list(ctx, count);
+    }
+
+    auto write_frame_header(
+      context_param ctx,
+      std::string_view name,
+      size_t size) -> write_errors {
+        _enter_element(ctx);
+        write_errors errors{_write_bytes(ctx, std::as_bytes(std::span(name)))};
+        if(MIRROR_LIKELY(!errors)) {
+            errors |= _write_varint(ctx, size);
+        }
+        return errors;
+    }
+
+    auto resume_index(context_param ctx) noexcept -> size_t
+      requires(tracking_data_sink<Sink>) {
+        return ctx.sink.tracker().resume_index();
+    }
+
+    auto finish(context_param) -> write_errors {
+        return {};
+    }
+
+private:
+    // the structure of the values is followed only by sinks that need it
+    static auto _position(context_param ctx) noexcept -> size_t {
+        if constexpr(tracking_data_sink<Sink>) {
+            return ctx.sink.stream_position();
+        } else {
+            return 0Z;
+        }
+    }
+
+    static auto _enter_level(context_param ctx, size_t count, size_t start)
+      noexcept -> std::variant<context, write_errors> {
+        if constexpr(tracking_data_sink<Sink>) {
+            auto& tracker{ctx.sink.tracker()};
+            if(MIRROR_UNLIKELY(!tracker.enter_level(count, start))) {
+                return write_errors{write_error_code::data_sink_error};
+            }
+        }
+        return {ctx};
+    }
+
+    static void _enter_element(context_param ctx) noexcept {
+        if constexpr(tracking_data_sink<Sink>) {
+            ctx.sink.tracker().enter_element(_position(ctx));
+        }
+    }
+
+    static void _leave_level(context_param ctx) noexcept {
+        if constexpr(tracking_data_sink<Sink>) {
+            ctx.sink.tracker().leave_level();
+        }
+    }
+
+    template <typename T>
+    static auto _write_scalar(context_param ctx, T value) noexcept
+      -> write_errors {
+        if constexpr(std::is_same_v<T, bool>) {
+            return _write_fixed(ctx, std::uint8_t(value ? 1U : 0U));
+        } else if constexpr(std::is_integral_v<T>) {
+            return _write_fixed(ctx, std::make_unsigned_t<T>(value));
+        } else if constexpr(std::is_same_v<T, float>) {
+            return _write_fixed(ctx, std::bit_cast<std::uint32_t>(value));
+        } else {
+            return _write_fixed(ctx, std::bit_cast<std::uint64_t>(value));
+        }
+    }
+
+    static auto _write_bytes(
+      context_param ctx,
+      std::span<const std::byte> bytes) noexcept -> write_errors {
+        write_errors errors{_write_varint(ctx, bytes.size())};
+        if(MIRROR_LIKELY(!errors)) {
+            errors |= ctx.sink.append(bytes);
+        }
+        return errors;
+    }
+
+    template <typename U>
+    static auto _write_fixed(context_param ctx, U value) noexcept
+      -> write_errors {
+        static_assert(std::is_unsigned_v<U>);
+        std::array<std::byte, sizeof(U)> bytes{};
+        for(size_t i = 0Z; i < sizeof(U); ++i) {
+            bytes[i] = std::byte(value >> (8U * i));
+        }
+        return ctx.sink.append(bytes);
+    }
+
+    static auto _write_varint(context_param ctx, std::uint64_t value) noexcept
+      -> write_errors {
+        std::array<std::byte, 10Z> bytes{};
+        size_t len = 0Z;
+        while(value >= 0x80U) {
+            bytes[len++] = std::byte((value & 0x7FU) | 0x80U);
+            value >>= 7U;
+        }
+        bytes[len++] = std::byte(value);
+        return ctx.sink.append(std::span(bytes).first(len));
+    }
+};
+//------------------------------------------------------------------------------
+/// @brief Serializes a value in the compact binary format into a data sink.
+/// @ingroup serialization
+/// @see read_binary
+template <typename T, data_sink Sink>
+auto write_binary(const T& value, Sink& sink) noexcept -> write_errors {
+    basic_binary_write_backend<Sink> backend;
+    return write(value, backend, {sink});
+}
+//------------------------------------------------------------------------------
+/// @brief Serializes a value in the compact binary format into a fixed buffer.
+/// @ingroup serialization
+/// @see read_binary
+/// On success @p dest is shrunk to the part that was written.
+template <typename T>
+auto write_binary(const T& value, std::span<std::byte>& dest) noexcept
+  -> write_errors {
+    span_data_sink sink{dest};
+    const auto errors{write_binary(value, sink)};
+    if(!errors) {
+        dest = sink.done();
+    }
+    return errors;
+}
+//------------------------------------------------------------------------------
+/// @brief Serializes a value in the compact binary format, appending to buffer.
+/// @ingroup serialization
+/// @see read_binary
+template <typename T>
+auto write_binary(const T& value, std::vector<std::byte>& buffer) noexcept
+  -> write_errors {
+    buffer_data_sink<> sink{buffer};
+    return write_binary(value, sink);
+}
+//------------------------------------------------------------------------------
+/// @brief Serializes a value in the compact binary format in bounded chunks.
+/// @ingroup serialization
+/// @see resumable_binary_reader
+/// @see resume_tracker
+///
+/// Each call to write_some fills the next chunk of the output and returns
+/// write_error_code::incomplete_write while there is more to write, so that
+/// the value can be streamed through a fixed-size buffer, for example into
+/// a non-blocking socket, without staging the whole representation. Between
+/// the calls the writer remembers the path to the list or record elements
+/// that did not fit, the next call continues with them instead of starting
+/// from the beginning of the value. The value must not change until the
+/// writing is done.
+template <typename T>
+class resumable_binary_writer {
+public:
+    resumable_binary_writer(const T& value) noexcept
+      : _value{value} {}
+
+    /// @brief Writes the next chunk into @p dest and shrinks it to that part.
+    auto write_some(std::span<std::byte>& dest) noexcept -> write_errors {
+        _tracker.restart();
+        _sink sink{dest, _done, _tracker};
+        const auto errors{write_binary(_value, sink)};
+        _done += sink.size();
+        _finished = !errors;
+        if(_finished) {
+            _tracker.reset();
+        }
+        dest = sink.done();
+        return errors;
+    }
+
+    /// @brief Indicates that the whole representation was written.
+    auto is_done() const noexcept -> bool {
+        return _finished;
+    }
+
+    /// @brief Returns the number of bytes written in all the chunks so far.
+    auto bytes_written() const noexcept -> size_t {
+        return _done;
+    }
+
+    /// @brief Starts writing from the beginning again.
+    void reset() noexcept {
+        _tracker.reset();
+        _done = 0Z;
+        _finished = false;
+    }
+
+private:
+    // writes the part of the stream following the bytes already written,
+    // nothing is written while the remembered elements are sought
+    class _sink {
+    public:
+        _sink(
+          std::span<std::byte> dest,
+          size_t done,
+          resume_tracker& tracker) noexcept
+          : _chunk{dest, done - tracker.anchor()}
+          , _position{tracker.anchor()}
+          , _tracker{tracker} {}
+
+        auto append(std::span<const std::byte> bytes) noexcept
+          -> write_errors {
+            if(_tracker.is_seeking()) {
+                return {};
+            }
+            _position += bytes.size();
+            const auto errors{_chunk.append(bytes)};
+            if(MIRROR_UNLIKELY(errors)) {
+                _tracker.suspend();
+            }
+            return errors;
+        }
+
+        auto tracker() const noexcept -> resume_tracker& {
+            return _tracker;
+        }
+
+        auto stream_position() const noexcept -> size_t {
+            return _position;
+        }
+
+        auto size() const noexcept -> size_t {
+            return _chunk.size();
+        }
+
+        auto done() const noexcept -> std::span<std::byte> {
+            return _chunk.done();
+        }
+
+    private:
+        chunked_data_sink _chunk;
+        size_t _position{0Z};
+        resume_tracker& _tracker;
+    };
+
+    const T& _value;
+    resume_tracker _tracker;
+    size_t _done{0Z};
+    bool _finished{false};
+};
+//------------------------------------------------------------------------------
+} // namespace mirror::serialize
+
+#endif // MIRROR_SERIALIZE_WRITE_BINARY_HPP
@@ -14,7 +14,9 @@
 #include "../tribool.hpp"
 #include "../utils/rapidjson.hpp"
 #include "write.hpp"
-#include <sstream>
+#include <ostream>
+#include <span>
+#include <string>
 
 MIRROR_DIAG_PUSH()
 #if defined(__clang__)
@@ -68,6 +70,10 @@ struct basic_rapidjson_write_backend {
         return true;
     }
 
+    auto bitfield_as_list(context_param) noexcept -> bool {
+        return true;
+    }
+
     auto begin(context_param ctx) -> std::variant<context, write_errors> {
         return {ctx};
     }
@@ -108,6 +114,8 @@ struct basic_rapidjson_write_backend {
         } else if constexpr(std::is_convertible_v<T, std::string_view>) {
             const std::string_view view{value};
             ctx.node.SetString(to_rapidjson(view));
+        } else if constexpr(std::is_same_v<T, std::span<const std::byte>>) {
+            return {write_error_code::not_supported};
         } else {
             return drv.write(*this, ctx, value);
         }
@@ -169,6 +177,202 @@ struct basic_rapidjson_write_backend {
     }
 };
 //------------------------------------------------------------------------------
+/// @brief Serialization backend driving a rapidjson SAX writer directly.
+/// @ingroup serialization
+/// @see basic_rapidjson_write_backend
+///
+/// Unlike basic_rapidjson_write_backend this does not build a document,
+/// the JSON text is emitted into the writer's output stream as the value
+/// is traversed, so the memory use does not depend on the size of the value.
+template <typename Writer>
+struct basic_rapidjson_sax_write_backend {
+    struct context {
+        Writer& writer;
+    };
+    using context_param = context;
+
+    auto enum_as_string(context_param) noexcept -> bool {
+        return true;
+    }
+
+    auto bitfield_as_list(context_param) noexcept -> bool {
+        return true;
+    }
+
+    auto begin(context_param ctx) -> std::variant<context, write_errors> {
+        return {ctx};
+    }
+
+    template <typename T>
+    auto write(const write_driver& drv, context_param ctx, const T& value)
+      -> write_errors {
+        bool ok{true};
+        if constexpr(std::is_arithmetic_v<T>) {
+            ok = _write_number(ctx.writer, value);
+        } else if constexpr(std::is_same_v<T, tribool>) {
+            if(value) {
+                ok = ctx.writer.Bool(true);
+            } else if(!value) {
+                ok = ctx.writer.Bool(false);
+            } else {
+                ok = ctx.writer.Null();
+            }
+        } else if constexpr(std::is_convertible_v<T, std::string_view>) {
+            const std::string_view view{value};
+            ok = ctx.writer.String(
+              view.data(), rapidjson::SizeType(view.size()));
+        } else if constexpr(std::is_same_v<T, std::span<const std::byte>>) {
+            return {write_error_code::not_supported};
+        } else {
+            return drv.write(*this, ctx, value);
+        }
+        return _result(ok);
+    }
+
+    auto begin_list(context_param ctx, size_t)
+      -> std::variant<context, write_errors> {
+        if(MIRROR_UNLIKELY(!ctx.writer.StartArray())) {
+            return write_errors{write_error_code::backend_error};
+        }
+        return {ctx};
+    }
+
+    template <typename T>
+    auto write_elements(context_param ctx, std::span<const T> values)
+      -> write_errors {
+        for(const T value : values) {
+            if(MIRROR_UNLIKELY(!_write_number(ctx.writer, value))) {
+                return {write_error_code::backend_error};
+            }
+        }
+        return {};
+    }
+
+    auto begin_element(context_param ctx, size_t)
+      -> std::variant<context, write_errors> {
+        return {ctx};
+    }
+
+    auto separate_element(context_param) -> write_errors {
+        return {};
+    }
+
+    auto finish_element(context_param, size_t) -> write_errors {
+        return {};
+    }
+
+    auto finish_list(context_param ctx) -> write_errors {
+        return _result(ctx.writer.EndArray());
+    }
+
+    auto begin_record(context_param ctx, size_t)
+      -> std::variant<context, write_errors> {
+        if(MIRROR_UNLIKELY(!ctx.writer.StartObject())) {
+            return write_errors{write_error_code::backend_error};
+        }
+        return {ctx};
+    }
+
+    auto begin_attribute(context_param ctx, std::string_view name)
+      -> std::variant<context, write_errors> {
+        if(MIRROR_UNLIKELY(
+             !ctx.writer.Key(name.data(), rapidjson::SizeType(name.size())))) {
+            return write_errors{write_error_code::backend_error};
+        }
+        return {ctx};
+    }
+
+    auto separate_attribute(context_param) -> write_errors {
+        return {};
+    }
+
+    auto finish_attribute(context_param, std::string_view) -> write_errors {
+        return {};
+    }
+
+    auto finish_record(context_param ctx) -> write_errors {
+        return _result(ctx.writer.EndObject());
+    }
+
+    auto finish(context_param ctx) -> write_errors {
+        ctx.writer.Flush();
+        return {};
+    }
+
+private:
+    template <typename T>
+    static auto _write_number(Writer& writer, T value) -> bool {
+        if constexpr(std::is_same_v<T, bool>) {
+            return writer.Bool(value);
+        } else if constexpr(std::is_integral_v<T>) {
+            if constexpr(std::is_signed_v<T>) {
+                if constexpr(sizeof(T) > 4Z) {
+                    return writer.Int64(value);
+                } else {
+                    return writer.Int(value);
+                }
+            } else {
+                if constexpr(sizeof(T) > 4Z) {
+                    return writer.Uint64(value);
+                } else {
+                    return writer.Uint(value);
+                }
+            }
+        } else {
+            return writer.Double(double(value));
+        }
+    }
+
+    static auto _result(bool ok) noexcept -> write_errors {
+        if(MIRROR_LIKELY(ok)) {
+            return {};
+        }
+        return {write_error_code::backend_error};
+    }
+};
+//------------------------------------------------------------------------------
+/// @brief Adapter allowing rapidjson writers to append directly to a string.
+/// @ingroup serialization
+class rapidjson_string_output_stream {
+public:
+    using Ch = char;
+
+    rapidjson_string_output_stream(std::string& dest) noexcept
+      : _dest{dest} {}
+
+    void Put(Ch c) noexcept {
+        if(MIRROR_LIKELY(!_failed)) {
+            try {
+                _dest.push_back(c);
+            } catch(...) {
+                _failed = true;
+            }
+        }
+    }
+
+    void Flush() noexcept {}
+
+    /// @brief Indicates if appending to the string failed.
+    auto has_failed() const noexcept -> bool {
+        return _failed;
+    }
+
+private:
+    std::string& _dest;
+    bool _failed{false};
+};
+//------------------------------------------------------------------------------
+/// @brief Serializes a value as JSON text through the specified SAX writer.
+/// @ingroup serialization
+/// The output stream of the writer must not throw, failures of the stream
+/// should be checked by the caller after the serialization.
+template <typename T, typename Writer>
+auto write_rapidjson_sax(const T& value, Writer& writer) noexcept
+  -> write_errors {
+    basic_rapidjson_sax_write_backend<Writer> backend;
+    return write(value, backend, {writer});
+}
+//------------------------------------------------------------------------------
 template <typename T, typename E, typename A>
 auto write_rapidjson(
   const T& value,
@@ -180,20 +384,31 @@ auto write_rapidjson(
 //------------------------------------------------------------------------------
 template <typename T>
 auto write_rapidjson_stream(const T& value, std::ostream& out) -> write_errors {
-    rapidjson::Document doc;
-    auto errors = mirror::serialize::write_rapidjson(value, doc);
-
+    // the stream must not throw from inside of the serialization,
+    // restoring the exception mask rethrows a failure if it was requested
+    const auto exceptions{out.exceptions()};
+    out.exceptions(std::ios::goodbit);
     rapidjson::OStreamWrapper stream(out);
     rapidjson::Writer<rapidjson::OStreamWrapper> writer(stream);
-    doc.Accept(writer);
+    auto errors{write_rapidjson_sax(value, writer)};
+    if(MIRROR_UNLIKELY(!out)) {
+        errors |= write_error_code::data_sink_error;
+    }
+    out.exceptions(exceptions);
     return errors;
 }
 //------------------------------------------------------------------------------
+/// @brief Serializes a value as JSON text into a string, reusing its storage.
+/// @ingroup serialization
 template <typename T>
 auto write_rapidjson_string(const T& value, std::string& str) -> write_errors {
-    std::stringstream out;
-    auto errors = write_rapidjson_stream(value, out);
-    str = out.str();
+    str.clear();
+    rapidjson_string_output_stream stream(str);
+    rapidjson::Writer<rapidjson_string_output_stream> writer(stream);
+    auto errors{write_rapidjson_sax(value, writer)};
+    if(MIRROR_UNLIKELY(stream.has_failed())) {
+        errors |= write_error_code::data_sink_error;
+    }
     return errors;
 }
 //------------------------------------------------------------------------------
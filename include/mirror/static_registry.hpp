@@ -0,0 +1,334 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef MIRROR_STATIC_REGISTRY_HPP
+#define MIRROR_STATIC_REGISTRY_HPP
+
+#include "registry.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace mirror {
+
+class static_metadata;
+
+// holds the static metadata for the metaobject MO
+template <typename Roots, typename MO>
+struct _static_metadata_of;
+
+// holds the array of the elements of the metaobject sequence MS
+template <typename Roots, typename MS>
+struct _static_elements_of;
+
+template <__metaobject_id... R, __metaobject_id M>
+consteval auto _is_static_root(
+  unpacked_metaobject_sequence<R...>,
+  wrapped_metaobject<M> mo) noexcept -> bool {
+    return (false || ... || reflects_same(wrapped_metaobject<R>{}, mo));
+}
+
+// like with metadata_registry::add, types are described in full only if they
+// are listed or if they are member types of such types
+template <typename Roots, __metaobject_id M>
+consteval auto _is_static_expanded(wrapped_metaobject<M> mo) noexcept -> bool {
+    if constexpr(reflects_type(mo)) {
+        if(_is_static_root(Roots{}, mo)) {
+            return true;
+        }
+        if constexpr(reflects_scope_member(mo)) {
+            if constexpr(reflects_type(get_scope(mo))) {
+                return _is_static_expanded<Roots>(get_scope(mo));
+            }
+        }
+        return false;
+    } else {
+        return true;
+    }
+}
+//------------------------------------------------------------------------------
+// the constructors are constexpr rather than consteval, so that the metadata
+// can refer to itself while it is being initialized
+class static_metadata : public stored_metadata {
+private:
+    template <typename Roots, operation_metaobject O, __metaobject_id M>
+    static constexpr auto
+    _link(wrapped_metaobject<M> mo, const metadata* pmd) noexcept
+      -> const metadata* {
+        if constexpr(mirror::is_applicable<O>(mo)) {
+            using MO = decltype(mirror::try_apply<O>(mo));
+            return &_static_metadata_of<Roots, MO>::value;
+        } else {
+            return pmd;
+        }
+    }
+
+    template <typename Roots, __metaobject_id M>
+    static constexpr auto
+    _link_base_type(wrapped_metaobject<M> mo, const metadata* pmd) noexcept
+      -> const metadata* {
+        if constexpr(reflects_type(mo)) {
+            using MO = decltype(get_base_type(mo));
+            return &_static_metadata_of<Roots, MO>::value;
+        } else if constexpr(reflects_typed(mo)) {
+            return _link_base_type<Roots>(get_type(mo), pmd);
+        } else {
+            return pmd;
+        }
+    }
+
+public:
+    constexpr static_metadata() noexcept = default;
+
+    template <typename Roots, __metaobject_id M>
+    constexpr static_metadata(
+      Roots,
+      wrapped_metaobject<M> mo,
+      const metadata& none) noexcept
+      : stored_metadata{mo, get_hash(mo), none} {
+        if constexpr(reflects_type(mo)) {
+            using MO = decltype(get_element_type(mo));
+            _element_type = &_static_metadata_of<Roots, MO>::value;
+        }
+        if constexpr(reflects_object_sequence(mo)) {
+            using MS = decltype(unpack(mo));
+            _set_static_elements(_static_elements_of<Roots, MS>::value);
+        } else if constexpr(reflects_object(mo)) {
+            if constexpr(_is_static_expanded<Roots>(mo)) {
+                using O = operation_metaobject;
+                _scope = _link<Roots, O::get_scope>(mo, _scope);
+                _type = _link<Roots, O::get_type>(mo, _type);
+                _base_type = _link_base_type<Roots>(mo, _base_type);
+                _underlying_type =
+                  _link<Roots, O::get_underlying_type>(mo, _underlying_type);
+                _aliased = _link<Roots, O::get_aliased>(mo, _aliased);
+                _class = _link<Roots, O::get_class>(mo, _class);
+
+                _base_classes =
+                  _link<Roots, O::get_base_classes>(mo, _base_classes);
+                _captures = _link<Roots, O::get_captures>(mo, _captures);
+                _constructors =
+                  _link<Roots, O::get_constructors>(mo, _constructors);
+                _data_members =
+                  _link<Roots, O::get_data_members>(mo, _data_members);
+                _destructors =
+                  _link<Roots, O::get_destructors>(mo, _destructors);
+                _enumerators =
+                  _link<Roots, O::get_enumerators>(mo, _enumerators);
+                _member_functions =
+                  _link<Roots, O::get_member_functions>(mo, _member_functions);
+                _member_types =
+                  _link<Roots, O::get_member_types>(mo, _member_types);
+                _operators = _link<Roots, O::get_operators>(mo, _operators);
+                _parameters = _link<Roots, O::get_parameters>(mo, _parameters);
+            }
+        }
+    }
+};
+//------------------------------------------------------------------------------
+struct _static_no_metadata_of {
+    static constexpr const static_metadata value{};
+};
+
+template <typename Roots, __metaobject_id M>
+struct _static_metadata_of<Roots, wrapped_metaobject<M>> {
+    static constexpr const static_metadata value{
+      Roots{},
+      wrapped_metaobject<M>{},
+      _static_no_metadata_of::value};
+};
+
+template <typename Roots, __metaobject_id... M>
+struct _static_elements_of<Roots, unpacked_metaobject_sequence<M...>> {
+    static constexpr const std::array<const metadata*, sizeof...(M)> value{
+      {&_static_metadata_of<Roots, wrapped_metaobject<M>>::value...}};
+};
+//------------------------------------------------------------------------------
+// set of the ids of the visited metadata, used only during compilation
+class _static_id_set {
+private:
+    std::vector<hash_t> _ids;
+    std::vector<bool> _used;
+    size_t _count{0Z};
+
+    static constexpr auto _home(hash_t id, size_t mask) noexcept -> size_t {
+        id *= 0x9E3779B97F4A7C15ULL;
+        return size_t(id ^ (id >> 32U)) & mask;
+    }
+
+    constexpr void _place(hash_t id) noexcept {
+        const size_t mask{_ids.size() - 1Z};
+        size_t pos{_home(id, mask)};
+        while(_used[pos]) {
+            pos = (pos + 1Z) & mask;
+        }
+        _ids[pos] = id;
+        _used[pos] = true;
+    }
+
+public:
+    constexpr _static_id_set() noexcept
+      : _ids(64Z)
+      , _used(64Z) {}
+
+    // returns false if the id was already in the set
+    constexpr auto insert(hash_t id) -> bool {
+        const size_t mask{_ids.size() - 1Z};
+        for(size_t pos{_home(id, mask)}; _used[pos]; pos = (pos + 1Z) & mask) {
+            if(_ids[pos] == id) {
+                return false;
+            }
+        }
+        if(2Z * (_count + 1Z) > _ids.size()) {
+            const size_t capacity{2Z * _ids.size()};
+            auto ids{std::exchange(_ids, std::vector<hash_t>(capacity))};
+            auto used{std::exchange(_used, std::vector<bool>(capacity))};
+            for(size_t i = 0Z; i < ids.size(); ++i) {
+                if(used[i]) {
+                    _place(ids[i]);
+                }
+            }
+        }
+        _place(id);
+        ++_count;
+        return true;
+    }
+};
+
+// collects the metadata reachable from the roots, without duplicates
+template <__metaobject_id... M>
+constexpr auto
+_collect_static_metadata(unpacked_metaobject_sequence<M...> roots)
+  -> std::vector<const metadata*> {
+    using Roots = decltype(roots);
+    const metadata* const none{&_static_no_metadata_of::value};
+    std::vector<const metadata*> result{none};
+    std::vector<const metadata*> pending{
+      &_static_metadata_of<Roots, wrapped_metaobject<M>>::value...};
+    _static_id_set visited;
+    while(!pending.empty()) {
+        const metadata* pmd{pending.back()};
+        pending.pop_back();
+        if(pmd == none || !visited.insert(pmd->id())) {
+            continue;
+        }
+        result.push_back(pmd);
+        for(const metadata* related :
+            {&pmd->scope(),
+             &pmd->type(),
+             &pmd->base_type(),
+             &pmd->element_type(),
+             &pmd->underlying_type(),
+             &pmd->aliased(),
+             &pmd->class_(),
+             &pmd->base_classes(),
+             &pmd->captures(),
+             &pmd->constructors(),
+             &pmd->data_members(),
+             &pmd->destructors(),
+             &pmd->enumerators(),
+             &pmd->member_functions(),
+             &pmd->member_types(),
+             &pmd->operators(),
+             &pmd->parameters()}) {
+            pending.push_back(related);
+        }
+        for(size_t i = 0Z; i < pmd->count(); ++i) {
+            pending.push_back(&pmd->element(i));
+        }
+    }
+    return result;
+}
+
+template <typename Roots>
+consteval auto _make_static_table() {
+    constexpr const size_t n{_collect_static_metadata(Roots{}).size()};
+    std::array<const metadata*, n> result{};
+    const auto collected{_collect_static_metadata(Roots{})};
+    std::copy(collected.begin(), collected.end(), result.begin());
+    return result;
+}
+
+// sorts a copy of the table, the metadata is not collected again
+template <size_t N>
+consteval auto _make_static_id_index(std::array<const metadata*, N> table) {
+    std::sort(table.begin(), table.end(), [](const auto* l, const auto* r) {
+        return l->id() < r->id();
+    });
+    return table;
+}
+//------------------------------------------------------------------------------
+/// @brief Registry of metadata built during compilation from metaobjects.
+/// @see metadata_registry
+///
+/// Contains the metadata that a metadata_registry would contain after adding
+/// the listed metaobjects to it. The metadata is stored in constant tables,
+/// so no work is done at startup and the tables can be placed in read-only
+/// memory shared between processes. The metadata query API works the same
+/// way as with the metadata_registry.
+template <__metaobject_id... M>
+class static_metadata_registry {
+private:
+    using _roots = unpacked_metaobject_sequence<M...>;
+
+    static constexpr const auto _table{_make_static_table<_roots>()};
+    // the metadata sorted by id, for lookup
+    static constexpr const auto _by_id{_make_static_id_index(_table)};
+
+public:
+    constexpr static_metadata_registry() noexcept = default;
+    constexpr static_metadata_registry(wrapped_metaobject<M>...) noexcept {}
+
+    static constexpr auto size() noexcept -> size_t {
+        return _table.size();
+    }
+
+    auto begin() const noexcept -> metadata_iterator {
+        return {_table.data()};
+    }
+
+    auto end() const noexcept -> metadata_iterator {
+        return {_table.data() + _table.size()};
+    }
+
+    auto get_none() const noexcept -> const metadata& {
+        return _static_no_metadata_of::value;
+    }
+
+    auto find(metaobject auto mo) const -> const metadata& {
+        constexpr const hash_t id{get_hash(decltype(mo){})};
+        const auto pos{std::lower_bound(
+          _by_id.begin(), _by_id.end(), id, [](const auto* pmd, hash_t key) {
+              return pmd->id() < key;
+          })};
+        if(pos == _by_id.end() || (*pos)->id() != id) {
+            throw metadata_not_found();
+        }
+        return **pos;
+    }
+
+    auto all() const noexcept -> metadata_sequence {
+        return metadata_sequence{std::span<const metadata* const>{_table}};
+    }
+
+    template <typename F>
+    auto filtered(F predicate) const -> metadata_sequence {
+        return all().filtered(predicate);
+    }
+};
+
+template <__metaobject_id... M>
+static_metadata_registry(wrapped_metaobject<M>...)
+  -> static_metadata_registry<M...>;
+//------------------------------------------------------------------------------
+} // namespace mirror
+
+#endif
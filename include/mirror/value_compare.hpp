@@ -0,0 +1,302 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef MIRROR_VALUE_COMPARE_HPP
+#define MIRROR_VALUE_COMPARE_HPP
+
+#include "placeholder.hpp"
+#include "primitives.hpp"
+#include "sequence.hpp"
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace mirror {
+//------------------------------------------------------------------------------
+template <typename... T>
+consteval auto _sum_sizeofs(type_list<T...>) noexcept -> size_t {
+    return (0Z + ... + sizeof(T));
+}
+
+/// @brief Indicates if there are padding bytes between the data members of T.
+/// @ingroup utilities
+template <typename T>
+consteval auto has_padding() noexcept -> bool {
+    return sizeof(T) >
+           _sum_sizeofs(extract_types(transform(
+             filter(get_data_members(mirror(T)), not_(is_static(_1))),
+             get_type(_1))));
+}
+//------------------------------------------------------------------------------
+template <typename T>
+struct value_compare;
+
+template <typename T>
+struct _value_compare_range;
+
+template <typename... T>
+consteval auto _all_bytewise(type_list<T...>) noexcept -> bool {
+    return (true && ... && value_compare<std::remove_cv_t<T>>::is_bytewise());
+}
+
+template <typename T>
+auto _bytewise_equal(const T* l, const T* r, size_t count) noexcept -> bool {
+    return count == 0Z || std::memcmp(l, r, count * sizeof(T)) == 0;
+}
+//------------------------------------------------------------------------------
+/// @brief Reflection-based equality and ordering of values of type T.
+/// @ingroup utilities
+/// @see equal
+/// @see compare
+///
+/// User-defined records are compared member by member, in the order of
+/// declaration, other classes, like those from the standard library, with
+/// their operator == and operator <=>.
+/// If all the bits of the values of T take part in the comparison, because
+/// it is a scalar other than floating-point or a record without padding
+/// consisting of such, then equality is checked with a single memcmp.
+template <typename T>
+struct value_compare {
+private:
+    static consteval auto _compares_members() noexcept -> bool {
+        if constexpr(std::is_class_v<T>) {
+            return reflects_user_record(mirror(T));
+        } else {
+            return false;
+        }
+    }
+
+public:
+    /// @brief Indicates if values of T are equal exactly if their bytes are.
+    static consteval auto is_bytewise() noexcept -> bool {
+        if constexpr(
+          std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>) {
+            return true;
+        } else if constexpr(std::is_array_v<T>) {
+            return value_compare<std::remove_extent_t<T>>::is_bytewise();
+        } else if constexpr(_compares_members()) {
+            return !has_padding<T>() &&
+                   _all_bytewise(extract_types(transform(
+                     filter(get_data_members(mirror(T)), not_(is_static(_1))),
+                     get_type(_1))));
+        } else {
+            return false;
+        }
+    }
+
+    static auto equal(const T& l, const T& r) noexcept -> bool {
+        if constexpr(is_bytewise()) {
+            return std::memcmp(&l, &r, sizeof(T)) == 0;
+        } else if constexpr(std::is_scalar_v<T>) {
+            return l == r;
+        } else if constexpr(std::is_array_v<T>) {
+            constexpr const auto n{std::extent_v<T>};
+            return _value_compare_range<std::remove_extent_t<T>>::equal(
+              l, n, r, n);
+        } else if constexpr(!_compares_members()) {
+            return l == r;
+        } else {
+            bool result = true;
+            for_each(
+              filter(get_data_members(mirror(T)), not_(is_static(_1))),
+              [&](auto mdm) {
+                  using M = std::remove_cvref_t<decltype(get_value(mdm, l))>;
+                  result = result && value_compare<M>::equal(
+                                       get_value(mdm, l), get_value(mdm, r));
+              });
+            return result;
+        }
+    }
+
+    static auto compare(const T& l, const T& r) noexcept
+      -> std::partial_ordering {
+        if constexpr(std::is_scalar_v<T>) {
+            return std::compare_three_way{}(l, r);
+        } else if constexpr(std::is_array_v<T>) {
+            constexpr const auto n{std::extent_v<T>};
+            return _value_compare_range<std::remove_extent_t<T>>::compare(
+              l, n, r, n);
+        } else if constexpr(!_compares_members()) {
+            return std::compare_three_way{}(l, r);
+        } else {
+            auto result{std::partial_ordering::equivalent};
+            for_each(
+              filter(get_data_members(mirror(T)), not_(is_static(_1))),
+              [&](auto mdm) {
+                  using M = std::remove_cvref_t<decltype(get_value(mdm, l))>;
+                  if(result == 0) {
+                      result = value_compare<M>::compare(
+                        get_value(mdm, l), get_value(mdm, r));
+                  }
+              });
+            return result;
+        }
+    }
+};
+//------------------------------------------------------------------------------
+template <typename T>
+struct _value_compare_range {
+    static consteval auto is_bytewise() noexcept -> bool {
+        return false;
+    }
+
+    static auto equal(const T* l, size_t ls, const T* r, size_t rs) noexcept
+      -> bool {
+        if(ls != rs) {
+            return false;
+        }
+        if constexpr(value_compare<T>::is_bytewise()) {
+            return _bytewise_equal(l, r, ls);
+        } else {
+            for(size_t i = 0; i < ls; ++i) {
+                if(!value_compare<T>::equal(l[i], r[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    static auto compare(const T* l, size_t ls, const T* r, size_t rs) noexcept
+      -> std::partial_ordering {
+        return std::lexicographical_compare_three_way(
+          l, l + ls, r, r + rs, [](const T& le, const T& re) {
+              return value_compare<T>::compare(le, re);
+          });
+    }
+};
+//------------------------------------------------------------------------------
+template <typename C, typename Tr, typename A>
+struct value_compare<std::basic_string<C, Tr, A>> {
+    static consteval auto is_bytewise() noexcept -> bool {
+        return false;
+    }
+
+    static auto equal(
+      const std::basic_string<C, Tr, A>& l,
+      const std::basic_string<C, Tr, A>& r) noexcept -> bool {
+        return l == r;
+    }
+
+    static auto compare(
+      const std::basic_string<C, Tr, A>& l,
+      const std::basic_string<C, Tr, A>& r) noexcept -> std::partial_ordering {
+        return l <=> r;
+    }
+};
+//------------------------------------------------------------------------------
+template <typename C, typename Tr>
+struct value_compare<std::basic_string_view<C, Tr>> {
+    static consteval auto is_bytewise() noexcept -> bool {
+        return false;
+    }
+
+    static auto equal(
+      std::basic_string_view<C, Tr> l,
+      std::basic_string_view<C, Tr> r) noexcept -> bool {
+        return l == r;
+    }
+
+    static auto compare(
+      std::basic_string_view<C, Tr> l,
+      std::basic_string_view<C, Tr> r) noexcept -> std::partial_ordering {
+        return l <=> r;
+    }
+};
+//------------------------------------------------------------------------------
+template <typename T, typename A>
+struct value_compare<std::vector<T, A>> : _value_compare_range<T> {
+    static auto equal(
+      const std::vector<T, A>& l,
+      const std::vector<T, A>& r) noexcept -> bool {
+        return _value_compare_range<T>::equal(
+          l.data(), l.size(), r.data(), r.size());
+    }
+
+    static auto compare(
+      const std::vector<T, A>& l,
+      const std::vector<T, A>& r) noexcept -> std::partial_ordering {
+        return _value_compare_range<T>::compare(
+          l.data(), l.size(), r.data(), r.size());
+    }
+};
+//------------------------------------------------------------------------------
+template <typename T, size_t N>
+struct value_compare<std::array<T, N>> : _value_compare_range<T> {
+    static consteval auto is_bytewise() noexcept -> bool {
+        return value_compare<T>::is_bytewise() &&
+               sizeof(std::array<T, N>) == N * sizeof(T);
+    }
+
+    static auto equal(
+      const std::array<T, N>& l,
+      const std::array<T, N>& r) noexcept -> bool {
+        return _value_compare_range<T>::equal(l.data(), N, r.data(), N);
+    }
+
+    static auto compare(
+      const std::array<T, N>& l,
+      const std::array<T, N>& r) noexcept -> std::partial_ordering {
+        return _value_compare_range<T>::compare(l.data(), N, r.data(), N);
+    }
+};
+//------------------------------------------------------------------------------
+template <typename T>
+struct value_compare<std::optional<T>> {
+    static consteval auto is_bytewise() noexcept -> bool {
+        return false;
+    }
+
+    static auto equal(
+      const std::optional<T>& l,
+      const std::optional<T>& r) noexcept -> bool {
+        if(l && r) {
+            return value_compare<T>::equal(*l, *r);
+        }
+        return l.has_value() == r.has_value();
+    }
+
+    // an empty optional is ordered before any value
+    static auto compare(
+      const std::optional<T>& l,
+      const std::optional<T>& r) noexcept -> std::partial_ordering {
+        if(l && r) {
+            return value_compare<T>::compare(*l, *r);
+        }
+        return l.has_value() <=> r.has_value();
+    }
+};
+//------------------------------------------------------------------------------
+/// @brief Indicates if two values are equal, comparing records member-wise.
+/// @ingroup utilities
+/// @see compare
+/// @see value_compare
+template <typename T>
+auto equal(const T& l, const T& r) noexcept -> bool {
+    return value_compare<T>::equal(l, r);
+}
+
+/// @brief Compares two values, ordering records lexicographically by members.
+/// @ingroup utilities
+/// @see equal
+/// @see value_compare
+template <typename T>
+auto compare(const T& l, const T& r) noexcept -> std::partial_ordering {
+    return value_compare<T>::compare(l, r);
+}
+//------------------------------------------------------------------------------
+} // namespace mirror
+
+#endif // MIRROR_VALUE_COMPARE_HPP
@@ -0,0 +1,326 @@
+/// @file
+///
+/// Copyright Matus Chochlik.
+/// Distributed under the Boost Software License, Version 1.0.
+/// See accompanying file LICENSE_1_0.txt or copy at
+///  http://www.boost.org/LICENSE_1_0.txt
+///
+
+#ifndef MIRROR_VALUE_HASH_HPP
+#define MIRROR_VALUE_HASH_HPP
+
+#include "placeholder.hpp"
+#include "primitives.hpp"
+#include "sequence.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mirror {
+//------------------------------------------------------------------------------
+// 64-bit block hash following the structure of XXH64
+//------------------------------------------------------------------------------
+constexpr const std::uint64_t _hash_p1{0x9E3779B185EBCA87ULL};
+constexpr const std::uint64_t _hash_p2{0xC2B2AE3D27D4EB4FULL};
+constexpr const std::uint64_t _hash_p3{0x165667B19E3779F9ULL};
+constexpr const std::uint64_t _hash_p4{0x85EBCA77C2B2AE63ULL};
+constexpr const std::uint64_t _hash_p5{0x27D4EB2F165667C5ULL};
+
+inline auto _hash_read64(const std::byte* p) noexcept -> std::uint64_t {
+    std::uint64_t result{};
+    std::memcpy(&result, p, sizeof(result));
+    return result;
+}
+
+inline auto _hash_read32(const std::byte* p) noexcept -> std::uint32_t {
+    std::uint32_t result{};
+    std::memcpy(&result, p, sizeof(result));
+    return result;
+}
+
+constexpr auto _hash_round(std::uint64_t acc, std::uint64_t input) noexcept
+  -> std::uint64_t {
+    return std::rotl(acc + input * _hash_p2, 31) * _hash_p1;
+}
+
+constexpr auto _hash_merge(std::uint64_t acc, std::uint64_t val) noexcept
+  -> std::uint64_t {
+    return (acc ^ _hash_round(0U, val)) * _hash_p1 + _hash_p4;
+}
+
+constexpr auto _hash_avalanche(std::uint64_t h) noexcept -> std::uint64_t {
+    h ^= h >> 33U;
+    h *= _hash_p2;
+    h ^= h >> 29U;
+    h *= _hash_p3;
+    h ^= h >> 32U;
+    return h;
+}
+
+/// @brief Mixes the specified 64-bit word into a running value hash.
+/// @ingroup utilities
+/// @see hash_bytes
+constexpr auto hash_combine(std::uint64_t seed, std::uint64_t value) noexcept
+  -> std::uint64_t {
+    return std::rotl(seed ^ _hash_round(0U, value), 27) * _hash_p1 + _hash_p4;
+}
+
+/// @brief Hashes a contiguous block of bytes, starting from the seed value.
+/// @ingroup utilities
+/// @see hash_combine
+/// @see value_hash
+inline auto hash_bytes(
+  std::span<const std::byte> bytes,
+  std::uint64_t seed) noexcept -> std::uint64_t {
+    const std::byte* p{bytes.data()};
+    const std::byte* const e{p + bytes.size()};
+    std::uint64_t h{};
+
+    if(bytes.size() >= 32Z) {
+        std::uint64_t v1{seed + _hash_p1 + _hash_p2};
+        std::uint64_t v2{seed + _hash_p2};
+        std::uint64_t v3{seed};
+        std::uint64_t v4{seed - _hash_p1};
+        do {
+            v1 = _hash_round(v1, _hash_read64(p));
+            v2 = _hash_round(v2, _hash_read64(p + 8));
+            v3 = _hash_round(v3, _hash_read64(p + 16));
+            v4 = _hash_round(v4, _hash_read64(p + 24));
+            p += 32;
+        } while(e - p >= 32);
+        h = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) +
+            std::rotl(v4, 18);
+        h = _hash_merge(h, v1);
+        h = _hash_merge(h, v2);
+        h = _hash_merge(h, v3);
+        h = _hash_merge(h, v4);
+    } else {
+        h = seed + _hash_p5;
+    }
+    h += std::uint64_t(bytes.size());
+
+    for(; e - p >= 8; p += 8) {
+        h = hash_combine(h, _hash_read64(p));
+    }
+    if(e - p >= 4) {
+        h ^= std::uint64_t(_hash_read32(p)) * _hash_p1;
+        h = std::rotl(h, 23) * _hash_p2 + _hash_p3;
+        p += 4;
+    }
+    for(; p != e; ++p) {
+        h ^= std::uint64_t(std::to_integer<std::uint8_t>(*p)) * _hash_p5;
+        h = std::rotl(h, 11) * _hash_p1;
+    }
+    return _hash_avalanche(h);
+}
+//------------------------------------------------------------------------------
+template <typename T>
+struct value_hash;
+
+template <typename T>
+struct _value_hash_base {
+    /// @brief Returns the hash of the specified value.
+    auto operator()(const T& value) const noexcept -> std::size_t {
+        return std::size_t(_hash_avalanche(value_hash<T>::combine(0U, value)));
+    }
+};
+
+template <typename T>
+auto _hash_elements(std::uint64_t seed, std::span<const T> elems) noexcept
+  -> std::uint64_t {
+    if constexpr(std::has_unique_object_representations_v<T>) {
+        return hash_bytes(std::as_bytes(elems), seed);
+    } else {
+        seed = hash_combine(seed, std::uint64_t(elems.size()));
+        for(const auto& elem : elems) {
+            seed = value_hash<T>::combine(seed, elem);
+        }
+        return seed;
+    }
+}
+//------------------------------------------------------------------------------
+/// @brief Reflection-based hash function object for values of type T.
+/// @ingroup utilities
+/// @see hash_bytes
+///
+/// Values whose object representation is unique, like integers, enumerations
+/// or records of such without padding, are hashed as a single block of bytes.
+/// User-defined records are hashed member by member, where adjacent members
+/// with unique representations are merged into blocks. Strings, vectors,
+/// arrays, optionals, pairs and tuples are hashed by their contents, as are
+/// the other standard containers, where the hash of unordered containers does
+/// not depend on the order of their elements. Other standard library classes
+/// are hashed with std::hash. Usable as the hasher of unordered containers.
+/// The hashes are not portable between platforms.
+template <typename T>
+struct value_hash : _value_hash_base<T> {
+    /// @brief Mixes the hash of the specified value into the seed.
+    static auto combine(std::uint64_t seed, const T& value) noexcept
+      -> std::uint64_t {
+        if constexpr(std::has_unique_object_representations_v<T>) {
+            return hash_bytes(
+              std::as_bytes(std::span<const T, 1>(&value, 1)), seed);
+        } else if constexpr(std::is_floating_point_v<T>) {
+            // adding zero makes negative and positive zero equal
+            return hash_combine(
+              seed, std::bit_cast<std::uint64_t>(double(value) + 0.0));
+        } else {
+            static_assert(std::is_class_v<T>);
+            if constexpr(reflects_user_record(mirror(T))) {
+                return _combine_members(seed, value);
+            } else if constexpr(std::ranges::input_range<const T>) {
+                return _combine_range(seed, value);
+            } else {
+                return hash_combine(seed, std::uint64_t(std::hash<T>{}(value)));
+            }
+        }
+    }
+
+private:
+    static auto _combine_members(std::uint64_t seed, const T& value) noexcept
+      -> std::uint64_t {
+        const std::byte* run_begin{nullptr};
+        const std::byte* run_end{nullptr};
+        const auto flush = [&]() {
+            if(run_begin != run_end) {
+                seed = hash_bytes(
+                  {run_begin, std::size_t(run_end - run_begin)}, seed);
+            }
+            run_begin = run_end = nullptr;
+        };
+        for_each(
+          filter(get_data_members(mirror(T)), not_(is_static(_1))),
+          [&](auto mdm) {
+              const auto& member{get_value(mdm, value)};
+              using M = std::remove_cvref_t<decltype(member)>;
+              if constexpr(std::has_unique_object_representations_v<M>) {
+                  const auto* pos{
+                    reinterpret_cast<const std::byte*>(
+                      std::addressof(member))};
+                  if(pos != run_end) {
+                      flush();
+                      run_begin = pos;
+                  }
+                  run_end = pos + sizeof(M);
+              } else {
+                  flush();
+                  seed = value_hash<M>::combine(seed, member);
+              }
+          });
+        flush();
+        return seed;
+    }
+
+    static auto _combine_range(std::uint64_t seed, const T& value) noexcept
+      -> std::uint64_t {
+        using E = std::remove_cv_t<std::ranges::range_value_t<const T>>;
+        std::uint64_t count{0U};
+        if constexpr(requires { typename T::hasher; }) {
+            // the order of the elements of unordered containers is unspecified
+            std::uint64_t sum{0U};
+            for(const auto& elem : value) {
+                sum += _hash_avalanche(value_hash<E>::combine(0U, elem));
+                ++count;
+            }
+            return hash_combine(hash_combine(seed, count), sum);
+        } else {
+            for(const auto& elem : value) {
+                seed = value_hash<E>::combine(seed, elem);
+                ++count;
+            }
+            return hash_combine(seed, count);
+        }
+    }
+};
+//------------------------------------------------------------------------------
+template <typename C, typename Tr, typename A>
+struct value_hash<std::basic_string<C, Tr, A>>
+  : _value_hash_base<std::basic_string<C, Tr, A>> {
+    static auto combine(
+      std::uint64_t seed,
+      const std::basic_string<C, Tr, A>& value) noexcept -> std::uint64_t {
+        return _hash_elements(seed, std::span<const C>(value));
+    }
+};
+//------------------------------------------------------------------------------
+template <typename C, typename Tr>
+struct value_hash<std::basic_string_view<C, Tr>>
+  : _value_hash_base<std::basic_string_view<C, Tr>> {
+    static auto combine(
+      std::uint64_t seed,
+      std::basic_string_view<C, Tr> value) noexcept -> std::uint64_t {
+        return _hash_elements(seed, std::span<const C>(value));
+    }
+};
+//------------------------------------------------------------------------------
+template <typename T, typename A>
+struct value_hash<std::vector<T, A>> : _value_hash_base<std::vector<T, A>> {
+    static auto combine(
+      std::uint64_t seed,
+      const std::vector<T, A>& value) noexcept -> std::uint64_t {
+        return _hash_elements(seed, std::span<const T>(value));
+    }
+};
+//------------------------------------------------------------------------------
+template <typename T, std::size_t N>
+struct value_hash<std::array<T, N>> : _value_hash_base<std::array<T, N>> {
+    static auto combine(
+      std::uint64_t seed,
+      const std::array<T, N>& value) noexcept -> std::uint64_t {
+        return _hash_elements(seed, std::span<const T>(value));
+    }
+};
+//------------------------------------------------------------------------------
+template <typename T>
+struct value_hash<std::optional<T>> : _value_hash_base<std::optional<T>> {
+    static auto combine(
+      std::uint64_t seed,
+      const std::optional<T>& value) noexcept -> std::uint64_t {
+        if(value) {
+            return value_hash<T>::combine(hash_combine(seed, 1U), *value);
+        }
+        return hash_combine(seed, 0U);
+    }
+};
+//------------------------------------------------------------------------------
+template <typename F, typename S>
+struct value_hash<std::pair<F, S>> : _value_hash_base<std::pair<F, S>> {
+    static auto combine(
+      std::uint64_t seed,
+      const std::pair<F, S>& value) noexcept -> std::uint64_t {
+        seed = value_hash<std::remove_cv_t<F>>::combine(seed, value.first);
+        return value_hash<std::remove_cv_t<S>>::combine(seed, value.second);
+    }
+};
+//------------------------------------------------------------------------------
+template <typename... T>
+struct value_hash<std::tuple<T...>> : _value_hash_base<std::tuple<T...>> {
+    static auto combine(
+      std::uint64_t seed,
+      const std::tuple<T...>& value) noexcept -> std::uint64_t {
+        std::apply(
+          [&](const auto&... elem) {
+              ((seed = value_hash<std::remove_cv_t<T>>::combine(seed, elem)),
+               ...);
+          },
+          value);
+        return seed;
+    }
+};
+//------------------------------------------------------------------------------
+} // namespace mirror
+
+#endif // MIRROR_VALUE_HASH_HPP